@@ -0,0 +1,96 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    BuildDatabase.Test.cpp
+// Description: This file defines all BuildDatabase unit tests.
+//
+// Created:     2026-10-17 20:58:42
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#include "BuildDatabase.h"
+#include "Hash.h"
+#include <UnitTest/UnitTest.h>
+using UnitTest::Assert;
+
+TEST_CLASS(BuildDatabaseTest)
+{
+public:
+	BuildDatabaseTest()
+	{
+	}
+
+	TEST_METHOD(EncodedRecordsLoad)
+	{
+		auto data = BuildDatabase::Encode(CreateRecords());
+		BuildDatabase database;
+		Assert::IsTrue(database.Load(data.data(), data.size()));
+		Assert::AreEqual(2ul, database.GetRecordCount());
+		Assert::AreEqual(3ul, static_cast<unsigned long>(database.fileNames.size()));
+
+		auto record = database.Decode(database.records["output/Main.o"]);
+		Assert::IsTrue(record.commandHash == Hash::Fnv1a("g++ -c Main.cpp"));
+		Assert::IsTrue(record.output.lastWriteTime == 500ull);
+		Assert::AreEqual(2ul, static_cast<unsigned long>(record.dependencies.size()));
+		Assert::AreEqual(std::string("c:\\project\\pch.h"), record.dependencies[1].fileName);
+		Assert::IsTrue(record.dependencies[1].stamp.size == 20ull);
+	}
+
+	TEST_METHOD(CheckComparesCommandAndStamps)
+	{
+		auto data = BuildDatabase::Encode(CreateRecords());
+		BuildDatabase database;
+		Assert::IsTrue(database.Load(data.data(), data.size()));
+		database.stamps["c:\\project\\Main.cpp"] = CreateStamp(100ull, 10ull);
+		database.stamps["c:\\project\\pch.h"] = CreateStamp(200ull, 20ull);
+		auto hash = Hash::Fnv1a("g++ -c Main.cpp");
+		auto output = CreateStamp(500ull, 50ull);
+
+		Assert::IsTrue(database.Check("output/Main.o", hash, output) == BuildDatabase::State::upToDate);
+		Assert::IsTrue(database.Check("output/Other.o", hash, output) == BuildDatabase::State::unknown);
+		Assert::IsTrue(database.Check("output/Main.o", Hash::Fnv1a("g++ -O3 -c Main.cpp"), output) == BuildDatabase::State::changed);
+		Assert::IsTrue(database.Check("output/Main.o", hash, CreateStamp(500ull, 51ull)) == BuildDatabase::State::changed);
+
+		database.stamps["c:\\project\\pch.h"] = CreateStamp(600ull, 20ull);
+		Assert::IsTrue(database.Check("output/Main.o", hash, output) == BuildDatabase::State::changed);
+
+		//A record updated during the build replaces the loaded one
+		auto record = CreateRecords()["output/Main.o"];
+		record.dependencies[1].stamp = CreateStamp(600ull, 20ull);
+		database.Update("output/Main.o", record);
+		Assert::IsTrue(database.Check("output/Main.o", hash, output) == BuildDatabase::State::upToDate);
+	}
+
+	TEST_METHOD(DamagedDataIsRejected)
+	{
+		auto data = BuildDatabase::Encode(CreateRecords());
+		BuildDatabase truncated;
+		Assert::IsTrue(!truncated.Load(data.data(), data.size() - 1));
+
+		data[0] = 'X';
+		BuildDatabase damaged;
+		Assert::IsTrue(!damaged.Load(data.data(), data.size()));
+	}
+
+private:
+	static BuildDatabase::Stamp CreateStamp(unsigned long long lastWriteTime, unsigned long long size)
+	{
+		BuildDatabase::Stamp stamp;
+		stamp.lastWriteTime = lastWriteTime;
+		stamp.size = size;
+		return stamp;
+	}
+
+	static std::map<std::string, BuildDatabase::Record> CreateRecords()
+	{
+		std::map<std::string, BuildDatabase::Record> records;
+		auto& main = records["output/Main.o"];
+		main.commandHash = Hash::Fnv1a("g++ -c Main.cpp");
+		main.output = CreateStamp(500ull, 50ull);
+		main.dependencies.push_back({ "c:\\project\\Main.cpp", CreateStamp(100ull, 10ull) });
+		main.dependencies.push_back({ "c:\\project\\pch.h", CreateStamp(200ull, 20ull) });
+		auto& other = records["output/Other.Test.o"];
+		other.commandHash = Hash::Fnv1a("g++ -c Other.Test.cpp");
+		other.output = CreateStamp(700ull, 70ull);
+		other.dependencies.push_back({ "c:\\project\\Other.Test.cpp", CreateStamp(300ull, 30ull) });
+		other.dependencies.push_back({ "c:\\project\\pch.h", CreateStamp(200ull, 20ull) });
+		return records;
+	}
+};
@@ -0,0 +1,330 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    BuildDatabase.cpp
+// Description: This file implements all BuildDatabase member functions.
+//
+// Created:     2026-10-17 20:58:42
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#include "pch.h"
+#include "BuildDatabase.h"
+#include <fstream>
+#include <stdexcept>
+
+//"CPDB" followed by the format version, older or newer databases are ignored
+const auto databaseMagic = 0x42445043ul;
+const auto databaseVersion = 1ul;
+
+BuildDatabase::~BuildDatabase()
+{
+	Close();
+}
+
+bool BuildDatabase::ReadStamp(const std::string& fileName, Stamp& stamp)
+{
+	WIN32_FILE_ATTRIBUTE_DATA data;
+	if (!::GetFileAttributesEx(fileName.c_str(), GetFileExInfoStandard, &data) ||
+		(data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0)
+		return false;
+	stamp.lastWriteTime = (static_cast<unsigned long long>(data.ftLastWriteTime.dwHighDateTime) << 32) | data.ftLastWriteTime.dwLowDateTime;
+	stamp.size = (static_cast<unsigned long long>(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+	return true;
+}
+
+bool BuildDatabase::Open(const std::string& fileName)
+{
+	constexpr auto trace = __PRETTY_FUNCTION__;
+	Close();
+	this->fileName = fileName;
+
+	//A missing or unreadable database is not an error (every object is checked from its includes once)
+	auto fileHandle = ::CreateFile(
+		fileName.c_str(),
+		GENERIC_READ,
+		FILE_SHARE_READ | FILE_SHARE_DELETE,
+		nullptr,
+		OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL,
+		nullptr);
+	if (fileHandle == INVALID_HANDLE_VALUE)
+		return false;
+	file.Attach(fileHandle);
+
+	LARGE_INTEGER size = {0};
+	ERR::CheckWindowsError(!::GetFileSizeEx(file.Get(), &size), trace, "GetFileSizeEx");
+	if (size.QuadPart == 0 || size.HighPart != 0)
+	{
+		Clear();
+		return false;
+	}
+
+	auto mappingHandle = ::CreateFileMapping(file.Get(), nullptr, PAGE_READONLY, 0, 0, nullptr);
+	ERR::CheckWindowsError(mappingHandle == nullptr, trace, "CreateFileMapping");
+	mapping.Attach(mappingHandle);
+
+	view = static_cast<const char*>(::MapViewOfFile(mapping.Get(), FILE_MAP_READ, 0, 0, 0));
+	ERR::CheckWindowsError(view == nullptr, trace, "MapViewOfFile");
+	if (!Load(view, size.QuadPart))
+	{
+		Clear();
+		return false;
+	}
+	return true;
+}
+
+void BuildDatabase::Close()
+{
+	Clear();
+	fileName.clear();
+	updates.clear();
+	stamps.clear();
+}
+
+void BuildDatabase::Save()
+{
+	constexpr auto trace = __PRETTY_FUNCTION__;
+
+	//A build where nothing compiled leaves the database untouched
+	std::map<std::string, Record> merged;
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		if (updates.empty())
+			return;
+		for (const auto& record: records)
+			if (updates.find(record.first) == updates.end())
+				merged[record.first] = Decode(record.second);
+		for (const auto& update: updates)
+			merged[update.first] = update.second;
+	}
+
+	auto data = Encode(merged);
+	auto tempFileName = fileName + ".tmp";
+	{
+		std::ofstream out(tempFileName.c_str(), std::ios::binary);
+		out.write(data.data(), data.size());
+		if (!out)
+			throw std::runtime_error{ "Could not write build database: " + tempFileName };
+	}
+
+	//The old file is still mapped, it has to be closed before it can be replaced
+	auto savedFileName = fileName;
+	Close();
+	auto result = ::MoveFileEx(tempFileName.c_str(), savedFileName.c_str(), MOVEFILE_REPLACE_EXISTING);
+	ERR::CheckWindowsError(!result, trace, "MoveFileEx");
+	Open(savedFileName);
+}
+
+BuildDatabase::State BuildDatabase::Check(const std::string& objectName, unsigned long long commandHash, const Stamp& output)
+{
+	auto isCurrent = [this](const std::string& fileName, const Stamp& recorded)
+	{
+		Stamp stamp;
+		return GetStamp(fileName, stamp) && stamp.lastWriteTime == recorded.lastWriteTime && stamp.size == recorded.size;
+	};
+
+	//Records compiled during this build take precedence over the mapped file
+	Record update;
+	auto isUpdated = false;
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		auto iter = updates.find(objectName);
+		if (iter != updates.end())
+		{
+			update = iter->second;
+			isUpdated = true;
+		}
+	}
+	if (isUpdated)
+	{
+		if (update.commandHash != commandHash || update.output.lastWriteTime != output.lastWriteTime || update.output.size != output.size)
+			return State::changed;
+		for (const auto& dependency: update.dependencies)
+			if (!isCurrent(dependency.fileName, dependency.stamp))
+				return State::changed;
+		return State::upToDate;
+	}
+
+	auto iter = records.find(objectName);
+	if (iter == records.end())
+		return State::unknown;
+
+	//Dependencies are read from the view without materializing the record
+	auto position = iter->second;
+	unsigned long long recordedHash = 0;
+	Stamp recordedOutput;
+	unsigned long dependencyCount = 0;
+	Read(position, viewEnd, recordedHash);
+	Read(position, viewEnd, recordedOutput.lastWriteTime);
+	Read(position, viewEnd, recordedOutput.size);
+	Read(position, viewEnd, dependencyCount);
+	if (recordedHash != commandHash || recordedOutput.lastWriteTime != output.lastWriteTime || recordedOutput.size != output.size)
+		return State::changed;
+	for (auto index = 0ul; index < dependencyCount; ++index)
+	{
+		unsigned long fileIndex = 0;
+		Stamp recorded;
+		Read(position, viewEnd, fileIndex);
+		Read(position, viewEnd, recorded.lastWriteTime);
+		Read(position, viewEnd, recorded.size);
+		if (!isCurrent(fileNames[fileIndex], recorded))
+			return State::changed;
+	}
+	return State::upToDate;
+}
+
+bool BuildDatabase::GetStamp(const std::string& fileName, Stamp& stamp)
+{
+	//Each file is read once per build no matter how many objects depend on it
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		auto iter = stamps.find(fileName);
+		if (iter != stamps.end())
+		{
+			stamp = iter->second;
+			return true;
+		}
+	}
+	if (!ReadStamp(fileName, stamp))
+		return false;
+	std::lock_guard<std::mutex> guard(lock);
+	stamps[fileName] = stamp;
+	return true;
+}
+
+void BuildDatabase::Update(const std::string& objectName, const Record& record)
+{
+	std::lock_guard<std::mutex> guard(lock);
+	updates[objectName] = record;
+}
+
+unsigned long BuildDatabase::GetRecordCount() const
+{
+	return records.size();
+}
+
+std::string BuildDatabase::Encode(const std::map<std::string, Record>& records)
+{
+	//Each file name is stored once and dependencies refer to it by index
+	std::vector<std::string> fileNames;
+	std::unordered_map<std::string, unsigned long> fileIndexes;
+	for (const auto& record: records)
+		for (const auto& dependency: record.second.dependencies)
+			if (fileIndexes.insert({ dependency.fileName, fileNames.size() }).second)
+				fileNames.push_back(dependency.fileName);
+
+	std::string out;
+	Write(out, databaseMagic);
+	Write(out, databaseVersion);
+	Write(out, static_cast<unsigned long>(fileNames.size()));
+	Write(out, static_cast<unsigned long>(records.size()));
+	for (const auto& fileName: fileNames)
+	{
+		Write(out, static_cast<unsigned long>(fileName.size()));
+		out += fileName;
+	}
+	for (const auto& record: records)
+	{
+		Write(out, static_cast<unsigned long>(record.first.size()));
+		out += record.first;
+		Write(out, record.second.commandHash);
+		Write(out, record.second.output.lastWriteTime);
+		Write(out, record.second.output.size);
+		Write(out, static_cast<unsigned long>(record.second.dependencies.size()));
+		for (const auto& dependency: record.second.dependencies)
+		{
+			Write(out, fileIndexes[dependency.fileName]);
+			Write(out, dependency.stamp.lastWriteTime);
+			Write(out, dependency.stamp.size);
+		}
+	}
+	return out;
+}
+
+bool BuildDatabase::Load(const char* data, unsigned long long size)
+{
+	//Everything is validated up front so that Check and Decode can read without bounds checks
+	auto position = data;
+	auto end = data + size;
+	unsigned long magic = 0, version = 0, fileCount = 0, recordCount = 0;
+	if (!Read(position, end, magic) || magic != databaseMagic ||
+		!Read(position, end, version) || version != databaseVersion ||
+		!Read(position, end, fileCount) ||
+		!Read(position, end, recordCount))
+		return false;
+
+	auto readString = [&](std::string& value)
+	{
+		unsigned long length = 0;
+		if (!Read(position, end, length) || static_cast<unsigned long long>(end - position) < length)
+			return false;
+		value.assign(position, length);
+		position += length;
+		return true;
+	};
+
+	fileNames.resize(fileCount);
+	for (auto& fileName: fileNames)
+		if (!readString(fileName))
+			return false;
+
+	const auto dependencySize = sizeof(unsigned long) + 2 * sizeof(unsigned long long);
+	for (auto index = 0ul; index < recordCount; ++index)
+	{
+		std::string objectName;
+		unsigned long long hash = 0;
+		Stamp output;
+		unsigned long dependencyCount = 0;
+		if (!readString(objectName))
+			return false;
+		auto body = position;
+		if (!Read(position, end, hash) ||
+			!Read(position, end, output.lastWriteTime) ||
+			!Read(position, end, output.size) ||
+			!Read(position, end, dependencyCount) ||
+			static_cast<unsigned long long>(end - position) / dependencySize < dependencyCount)
+			return false;
+		for (auto dependency = 0ul; dependency < dependencyCount; ++dependency)
+		{
+			unsigned long fileIndex = 0;
+			std::memcpy(&fileIndex, position, sizeof(fileIndex));
+			if (fileIndex >= fileCount)
+				return false;
+			position += dependencySize;
+		}
+		records[objectName] = body;
+	}
+	viewEnd = end;
+	return position == end;
+}
+
+BuildDatabase::Record BuildDatabase::Decode(const char* body) const
+{
+	Record record;
+	auto position = body;
+	unsigned long dependencyCount = 0;
+	Read(position, viewEnd, record.commandHash);
+	Read(position, viewEnd, record.output.lastWriteTime);
+	Read(position, viewEnd, record.output.size);
+	Read(position, viewEnd, dependencyCount);
+	record.dependencies.resize(dependencyCount);
+	for (auto& dependency: record.dependencies)
+	{
+		unsigned long fileIndex = 0;
+		Read(position, viewEnd, fileIndex);
+		Read(position, viewEnd, dependency.stamp.lastWriteTime);
+		Read(position, viewEnd, dependency.stamp.size);
+		dependency.fileName = fileNames[fileIndex];
+	}
+	return record;
+}
+
+void BuildDatabase::Clear()
+{
+	if (view != nullptr)
+		::UnmapViewOfFile(view);
+	view = nullptr;
+	viewEnd = nullptr;
+	mapping.Release();
+	file.Release();
+	fileNames.clear();
+	records.clear();
+}
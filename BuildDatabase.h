@@ -0,0 +1,106 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    BuildDatabase.h
+// Description: This file declares the BuildDatabase class.  The database is a
+//              compact binary file in the output folder that records, for each
+//              object file, the hash of the command that compiled it, the time
+//              and size of the object and of every file it depended on.  It is
+//              memory mapped when a build starts and records are read straight
+//              from the view, so deciding that nothing needs to compile takes
+//              one file stat per file (stats are shared by every object in the
+//              build).  Changed records are written back when the build ends.
+//
+// Created:     2026-10-17 20:58:42
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <CRL/WinUtility.h>
+
+class BuildDatabase
+{
+public:
+	struct Stamp
+	{
+		unsigned long long lastWriteTime = 0;
+		unsigned long long size = 0;
+	};
+
+	struct Dependency
+	{
+		std::string fileName;
+		Stamp stamp;
+	};
+
+	struct Record
+	{
+		unsigned long long commandHash = 0;
+		Stamp output;
+		std::vector<Dependency> dependencies;
+	};
+
+	enum class State
+	{
+		unknown,
+		changed,
+		upToDate
+	};
+
+	BuildDatabase() = default;
+	BuildDatabase(const BuildDatabase& rhs) = delete;
+	~BuildDatabase();
+
+	BuildDatabase& operator=(const BuildDatabase& rhs) = delete;
+
+	static bool ReadStamp(const std::string& fileName, Stamp& stamp);
+
+	bool Open(const std::string& fileName);
+	void Close();
+	void Save();
+
+	State Check(const std::string& objectName, unsigned long long commandHash, const Stamp& output);
+	bool GetStamp(const std::string& fileName, Stamp& stamp);
+	void Update(const std::string& objectName, const Record& record);
+	unsigned long GetRecordCount() const;
+
+private:
+	friend class BuildDatabaseTest;
+
+	static std::string Encode(const std::map<std::string, Record>& records);
+	bool Load(const char* data, unsigned long long size);
+	Record Decode(const char* body) const;
+	void Clear();
+
+	template <typename ValueType>
+	static void Write(std::string& out, ValueType value)
+	{
+		out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+	}
+
+	//Values are copied out because records are packed without alignment
+	template <typename ValueType>
+	static bool Read(const char*& position, const char* end, ValueType& value)
+	{
+		if (static_cast<unsigned long long>(end - position) < sizeof(value))
+			return false;
+		std::memcpy(&value, position, sizeof(value));
+		position += sizeof(value);
+		return true;
+	}
+
+private:
+	std::string fileName;
+	WIN::CHandle file;
+	WIN::CHandle mapping;
+	const char* view = nullptr;
+	const char* viewEnd = nullptr;
+	std::vector<std::string> fileNames;
+	std::unordered_map<std::string, const char*> records;
+	std::mutex lock;
+	std::map<std::string, Record> updates;
+	std::unordered_map<std::string, Stamp> stamps;
+};
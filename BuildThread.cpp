@@ -7,6 +7,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 #include "pch.h"
 #include "BuildThread.h"
+#include "WorkQueue.h"
 
 BuildThread::BuildThread()
 	: done(false)
@@ -21,11 +22,13 @@ void BuildThread::AddFileCompileSettings(const FileCompileSettings& setting)
 void BuildThread::Build(
 	CompileThreadEvents* events,
 	unsigned long id,
-	const std::string& workingDirectory)
+	const std::string& workingDirectory,
+	const std::string& databaseFile)
 {
 	this->events = events;
 	this->id = id;
 	this->workingDirectory = workingDirectory;
+	this->databaseFile = databaseFile;
 	Start();
 }
 
@@ -51,24 +54,32 @@ void BuildThread::Run()
 	try
 	{
 		events->ProcessMessage(id, "Build started.");
+		BuildDatabase database;
+		database.Open(databaseFile);
+
+		//Compiles wait in the shared pool until a worker is free, this thread sleeps until all are done
+		WorkQueue queue(ThreadPool::GetInstance());
 		unsigned long nextWorkerId = id + 1;
-		while (!settings.empty() && !events->IsStopping())
+		for (const auto& setting: settings)
 		{
-			while (workers.size() < std::thread::hardware_concurrency() && !settings.empty() && !events->IsStopping())
+			auto workerId = nextWorkerId++;
+			queue.Push([this, workerId, &setting, &database]()
 			{
-				CompileThreadPtr worker(new CompileThread());
-				worker->Compile(events, nextWorkerId++, settings.front(), workingDirectory);
-				workers.push_back(worker);
-				settings.pop_front();
-			}
-			TidyWorkers();
-			std::this_thread::yield();
+				if (events->IsStopping())
+					return;
+				CompileThread compiler;
+				compiler.Compile(events, workerId, setting, workingDirectory, &database);
+				compiler.Run();
+			});
 		}
-
-		while (!workers.empty())
+		queue.Wait();
+		SaveDatabase(database);
+		if (queue.GetJobCount() > 0)
 		{
-			TidyWorkers();
-			std::this_thread::yield();
+			std::ostringstream out;
+			out << queue.GetJobCount() << " files scheduled on " << queue.GetWorkerCount() << " workers ("
+				<< queue.GetOverheadPerJob() / 1000 << " us scheduler overhead per file).";
+			events->ProcessMessage(id, out.str());
 		}
 
 		if (project != nullptr && !objects.empty() && !events->IsStopping())
@@ -101,14 +112,21 @@ void BuildThread::Run()
 	done = true;
 }
 
-void BuildThread::TidyWorkers()
+void BuildThread::SaveDatabase(BuildDatabase& database)
 {
-	for (auto iter = workers.begin(); iter != workers.end(); )
+	//The compiles succeeded without it, an unsaved database only means the objects compiled
+	//by this build are compiled again by the next one
+	try
+	{
+		database.Save();
+	}
+	catch (const std::exception& error)
+	{
+		events->ProcessMessage(id, std::string("Warning: build database was not saved. ") + error.what());
+	}
+	catch (const ERR::CError& error)
 	{
-		if ((*iter)->IsDone())
-			iter = workers.erase(iter);
-		else
-			++iter;
+		events->ProcessMessage(id, "Warning: build database was not saved. " + error.Format());
 	}
 }
 
@@ -7,6 +7,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "BaseThread.h"
+#include "BuildDatabase.h"
 #include "CompileThread.h"
 #include "CompileThreadEvents.h"
 #include "FileCompileSettings.h"
@@ -30,19 +31,20 @@ public:
 	void Build(
 		CompileThreadEvents* events,
 		unsigned long id,
-		const std::string& workingDirectory);
+		const std::string& workingDirectory,
+		const std::string& databaseFile);
 	bool IsDone() const;
 
 	void Run() override;
 
 private:
-	void TidyWorkers();
+	void SaveDatabase(BuildDatabase& database);
 
 private:
 	unsigned long id = 0;
 	std::string workingDirectory;
+	std::string databaseFile;
 	std::list<FileCompileSettings> settings;
-	std::list<CompileThreadPtr> workers;
 	CompileThreadEvents* events = nullptr;
 	const Project* project = nullptr;
 	std::string objects;
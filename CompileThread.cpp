@@ -19,13 +19,14 @@ void CompileThread::Compile(
 	CompileThreadEvents* events,
 	unsigned long id,
 	const FileCompileSettings& settings,
-	const std::string& workingDirectory)
+	const std::string& workingDirectory,
+	BuildDatabase* database)
 {
 	this->events = events;
 	this->id = id;
 	this->settings = settings;
 	this->workingDirectory = workingDirectory;
-	Start();
+	this->database = database;
 }
 
 void CompileThread::Link(
@@ -55,9 +56,9 @@ void CompileThread::Run()
 	try
 	{
 		//Check if nothing needs to compile (done in thread instead of caller
-		//because time to check dependencies is not zero - requires -MM run of
-		//g++ and many file last write time accesses).
-		if (!linking && !settings.NeedsToCompile())
+		//because time to check dependencies is not zero - requires a file
+		//stat for each dependency and scanning includes the first time).
+		if (!linking && !settings.NeedsToCompile(*database))
 		{
 			events->ProcessMessage(id, settings.GetFileName() + " is up to date.");
 			done = true;
@@ -106,6 +107,9 @@ void CompileThread::Run()
 		std::string errorLine;
 		while (std::getline(errorIn, errorLine))
 			events->ProcessMessage(id, errorLine);
+
+		if (!linking && !events->IsStopping())
+			settings.RecordCompile(*database);
 	}
 	catch (const std::exception& error)
 	{
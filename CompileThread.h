@@ -7,6 +7,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "BaseThread.h"
+#include "BuildDatabase.h"
 #include "CompileThreadEvents.h"
 #include "FileCompileSettings.h"
 #include <atomic>
@@ -26,7 +27,8 @@ public:
 		CompileThreadEvents* events,
 		unsigned long id,
 		const FileCompileSettings& settings,
-		const std::string& workingDirectory);
+		const std::string& workingDirectory,
+		BuildDatabase* database);
 	void Link(
 		CompileThreadEvents* events,
 		unsigned long id,
@@ -69,6 +71,7 @@ private:
 	unsigned long id = 0;
 	FileCompileSettings settings;
 	std::string workingDirectory;
+	BuildDatabase* database = nullptr;
 	CompileThreadEvents* events = nullptr;
 	const Project* project = nullptr;
 	std::string objects;
@@ -0,0 +1,102 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    Document.Test.cpp
+// Description: This file defines all Document unit tests.
+//
+// Created:     2026-10-17 21:40:16
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#include "Document.h"
+#include <UnitTest/UnitTest.h>
+#include <stdexcept>
+using UnitTest::Assert;
+
+TEST_CLASS(DocumentTest)
+{
+public:
+	DocumentTest()
+	{
+	}
+
+	TEST_METHOD(TransactionsNestAndUndoAsOneStep)
+	{
+		Events events;
+		Document document;
+		Open(document, events);
+		{
+			Document::Transaction outer(document);
+			document.InsertText("one");
+			{
+				Document::Transaction inner(document);
+				document.InsertNewLine();
+				document.InsertText("two");
+			}
+			Assert::IsTrue(document.IsInTransaction());
+			Assert::AreEqual(0ul, events.linesChangedCount);
+		}
+		Assert::IsFalse(document.IsInTransaction());
+		Assert::AreEqual(1ul, events.linesChangedCount);
+		Assert::AreEqual(2ul, document.GetLineCount());
+		Assert::AreEqual(std::string("two"), document.GetLine(1));
+
+		document.Undo();
+		Assert::AreEqual(1ul, document.GetLineCount());
+		Assert::AreEqual(std::string(), document.GetLine(0));
+		Assert::IsFalse(document.CanUndo());
+	}
+
+	TEST_METHOD(TransactionEndsWhenEditThrows)
+	{
+		Events events;
+		Document document;
+		Open(document, events);
+		try
+		{
+			Document::Transaction transaction(document);
+			document.InsertText("partial");
+			throw std::runtime_error("edit failed");
+		}
+		catch (const std::runtime_error&)
+		{
+		}
+		Assert::IsFalse(document.IsInTransaction());
+		Assert::AreEqual(std::string("partial"), document.GetLine(0));
+
+		//Events are raised and edits are recorded again after the failed transaction
+		auto linesChangedCount = events.linesChangedCount;
+		document.InsertText("!");
+		Assert::AreEqual(linesChangedCount + 1, events.linesChangedCount);
+		document.Undo();
+		document.Undo();
+		Assert::AreEqual(std::string(), document.GetLine(0));
+	}
+
+private:
+	class Events : public DocumentEvents
+	{
+	public:
+		void OnDocumentSizeChanged(const DocumentMetrics& oldMetrics, const DocumentMetrics& newMetrics) override
+		{
+		}
+		void OnDocumentEditRegion(const DocumentPosition& start, const DocumentPosition& end) override
+		{
+		}
+		void OnDocumentSelectionChanged() override
+		{
+		}
+		void OnDocumentLinesChanged(const DocumentDamage& damage) override
+		{
+			++linesChangedCount;
+		}
+
+		unsigned long linesChangedCount = 0;
+	};
+
+	static void Open(Document& document, Events& events)
+	{
+		//A file that does not exist opens as one empty line
+		document.Open("Document.Test.missing", "Document.Test.missing");
+		while (document.IsOpening())
+			document.UpdateOpen();
+		document.SetEvents(&events);
+	}
+};
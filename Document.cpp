@@ -11,21 +11,74 @@
 #include "pch.h"
 #include "Document.h"
 #include "DocumentUtility.h"
+#include "DocumentPieceTable.h"
+#include "DocumentMappedFile.h"
+#include "DocumentFileWriter.h"
+#include "Settings.h"
+#include "Trace.h"
 #include <fstream>
 #include <iostream>
 #include <cassert>
+#include <limits>
+#include <chrono>
+#include <stdexcept>
+
+//Files at least this large are memory mapped instead of read line by line
+const auto mappedFileThreshold = 4ul * 1024ul * 1024ul;
+//Amount of a mapped file indexed before Open returns (enough for the first screen)
+const auto firstChunkSize = 64ul * 1024ul;
+//Number of cached line layouts kept before the cache is started over
+const auto maxLineLayouts = 64ul * 1024ul;
+//Time spent searching each time an incremental find is updated (and lines between clock checks)
+const auto findTimeSlice = std::chrono::milliseconds(15);
+const auto findClockInterval = 64ul;
+//Number of lines handed to the background lexer at a time
+const auto lexChunkSize = 16384ul;
+//Lines lexed after an edit to find where its recoloring ends (the rest of the file is redrawn past this)
+const auto maxRecolorLines = 1024ul;
+
+Document::Document()
+	: storage(new DocumentPieceTable())
+{
+}
 
 void Document::Open(const std::string& fileName, const std::string& relativeFileName)
 {
-	while (!undoBuffer.empty())
-		undoBuffer.pop();
-	while (!redoBuffer.empty())
-		redoBuffer.pop();
+	Trace::Span trace("open");
+	lexerThread.reset();
+	indexThread.reset();
+	openingFile = nullptr;
+	undoJournal.Clear();
+	undoJournal.SetBudget(Settings().GetUndoBudget());
 	selection.Clear();
-	lines.clear();
+	selections.Clear();
 
 	this->fileName = fileName;
 	this->relativeFileName = relativeFileName;
+	lineWidthCounts.clear();
+	lineLayouts.clear();
+	lexerCache.Clear();
+	damage.Clear();
+	++editVersion;
+
+	//Large files only build a line index here, the text is decoded as lines are displayed.
+	//The first screen is indexed right away and the rest is streamed in by a worker thread.
+	std::unique_ptr<DocumentMappedFile> file(new DocumentMappedFile());
+	if (file->Open(fileName, mappedFileThreshold, true))
+	{
+		file->IndexChunk(firstChunkSize);
+		for (auto index = 0ul; index < file->GetLineCount(); ++index)
+			++lineWidthCounts[file->GetLineLength(index)];
+		if (!file->IsIndexed())
+		{
+			openingFile = file.get();
+			indexThread.reset(new DocumentIndexThread(openingFile));
+		}
+		storage->Load(std::move(file));
+		return;
+	}
+
+	std::vector<std::string> lines;
 	std::ifstream in(fileName.c_str());
 	std::string line;
 	while (std::getline(in, line))
@@ -34,6 +87,41 @@ void Document::Open(const std::string& fileName, const std::string& relativeFile
 	//Make sure empty files display at least one line
 	if (lines.empty())
 		lines.push_back("");
+	for (const auto& line: lines)
+		AddLineWidth(line);
+	storage->Load(std::move(lines));
+}
+
+bool Document::IsOpening() const
+{
+	return openingFile != nullptr;
+}
+
+void Document::UpdateOpen()
+{
+	if (!IsOpening())
+		return;
+
+	Trace::Span trace("open");
+	//Check for completion before reading the line count so the final chunk is never missed
+	auto indexed = openingFile->IsIndexed();
+	auto firstLine = GetLineCount();
+	auto lineCount = openingFile->GetLineCount();
+	for (auto index = firstLine; index < lineCount; ++index)
+		++lineWidthCounts[openingFile->GetLineLength(index)];
+	storage->AppendOriginalLines(lineCount - firstLine);
+
+	if (indexed)
+	{
+		indexThread.reset();
+		openingFile = nullptr;
+	}
+
+	if (lineCount > firstLine && events != nullptr)
+	{
+		RaiseSizeChanged();
+		events->OnDocumentEditRegion(DocumentPosition(firstLine, 0), DocumentPosition(lineCount - 1, 0));
+	}
 }
 
 const std::string& Document::GetFileName() const
@@ -48,21 +136,85 @@ void Document::SetFileName(const std::string& value)
 
 bool Document::IsDirty() const
 {
-	return !undoBuffer.empty();
+	return undoJournal.CanUndo();
 }
 
 void Document::Save()
 {
-	std::ofstream out(fileName.c_str());
-	for (const auto& line: lines)
-		out << line << std::endl;
-	while (!undoBuffer.empty())
-		undoBuffer.pop();
+	//Nothing can have been edited until the document has finished opening
+	if (IsOpening())
+		return;
+
+	Trace::Span trace("save");
+	//Write a temporary file next to the original (same volume so it can be renamed over it).
+	//If anything fails before the rename the original file is left untouched.
+	auto tempFileName = fileName + ".tmp";
+	{
+		DocumentFileWriter writer;
+		writer.Open(tempFileName);
+		//Unedited lines of a mapped file are copied straight from the view (GetLine would cache them)
+		for (auto index = 0ul; index < GetLineCount(); ++index)
+		{
+			unsigned long length = 0;
+			auto text = storage->GetLineText(index, length);
+			writer.WriteLine(text, length);
+		}
+		writer.Close();
+	}
+
+	//Line references (the layout cache keys and the lexer chunk) are not valid once the storage is reloaded
+	lineLayouts.clear();
+	lexerThread.reset();
+
+	if (!storage->IsMapped())
+	{
+		//Reloading also compacts the storage (replaced lines are no longer kept in the add buffer)
+		storage->Load(CopyLines());
+		try
+		{
+			DocumentFileWriter::Replace(tempFileName, fileName);
+		}
+		catch (...)
+		{
+			//The target may be locked, do not leave the temporary file next to it
+			::DeleteFile(tempFileName.c_str());
+			throw;
+		}
+	}
+	else
+	{
+		//A memory mapped file cannot be replaced, so map the saved file before releasing it.
+		//The mapping follows the file when it is renamed, so the document is never left empty.
+		try
+		{
+			LoadSavedFile(tempFileName);
+		}
+		catch (...)
+		{
+			::DeleteFile(tempFileName.c_str());
+			throw;
+		}
+		try
+		{
+			DocumentFileWriter::Replace(tempFileName, fileName);
+		}
+		catch (...)
+		{
+			//Keep the content that was just written before reporting the error
+			storage->Load(CopyLines());
+			::DeleteFile(tempFileName.c_str());
+			throw;
+		}
+	}
+	undoJournal.ClearUndo();
 }
 
 void Document::SetEvents(DocumentEvents* events)
 {
+	//A new listener redraws everything, so edits made before it was attached are not reported
 	this->events = events;
+	damage.Clear();
+	metrics = GetMetrics();
 }
 
 SIZE Document::GetSize() const
@@ -70,34 +222,63 @@ SIZE Document::GetSize() const
 	return { static_cast<long>(GetMaxWidth()), static_cast<long>(GetLineCount()) };
 }
 
+DocumentMetrics Document::GetMetrics() const
+{
+	return DocumentMetrics(GetLineCount(), GetMaxWidth());
+}
+
 unsigned long Document::GetMaxWidth() const
 {
-	unsigned long maxWidth = 0;
-	for (const auto& line: lines)
-		maxWidth = MATH::Max(maxWidth, line.size());
-	return maxWidth;
+	//The largest width with a non-zero line count is the last entry of the ordered map
+	return lineWidthCounts.empty() ? 0 : lineWidthCounts.rbegin()->first;
 }
 
 unsigned long Document::GetLineCount() const
 {
-	return lines.size();
+	return storage->GetLineCount();
 }
 
 const std::string& Document::GetLine(unsigned long index) const
 {
-	return lines[index];
+	return storage->GetLine(index);
 }
 
 unsigned long Document::GetColumnWidth(unsigned long index) const
 {
-	return CalculateColumnWidth(lines[index]);
+	return GetLineLayout(index).GetColumnWidth();
+}
+
+const std::vector<DocumentLexer::Run>& Document::GetTokenRuns(unsigned long index) const
+{
+	return lexerCache.GetRuns(*storage, index);
+}
+
+bool Document::IsLexing() const
+{
+	return lexerThread != nullptr;
+}
+
+void Document::UpdateLexer()
+{
+	if (lexerThread)
+	{
+		if (!lexerThread->IsDone())
+			return;
+		lexerCache.MergeChunk(lexerThread->GetChunk());
+		lexerThread.reset();
+	}
+
+	//Lex the next run of stale lines in the background, painting only lexes what is still stale when shown
+	DocumentLexerCache::Chunk chunk;
+	if (lexerCache.GetNextChunk(*storage, lexChunkSize, chunk))
+		lexerThread.reset(new DocumentLexerThread(std::move(chunk)));
 }
 
 DocumentPosition Document::HitTest(const DocumentPosition& position) const
 {
-	auto line = MATH::Min(lines.size() - 1, position.GetLine());
-	auto index = CalculateIndexFromColumn(lines[line], position.GetColumn());
-	auto column = CalculateColumnWidth(lines[line].substr(0, index));
+	auto line = MATH::Min(GetLineCount() - 1, position.GetLine());
+	const auto& layout = GetLineLayout(line);
+	auto column = layout.GetColumnFromIndex(layout.GetIndexFromColumn(position.GetColumn()));
 	return DocumentPosition(line, column);
 }
 
@@ -125,10 +306,9 @@ std::string Document::GetSelectedText() const
 		if (start.GetColumn() == end.GetColumn())
 			return "";
 
-		const auto& line = lines[start.GetLine()];
-		auto firstIndex = CalculateIndexFromColumn(line, start.GetColumn());
-		auto lastIndex = CalculateIndexFromColumn(line, end.GetColumn());
-		return line.substr(firstIndex, lastIndex - firstIndex);
+		auto firstIndex = GetIndexFromColumn(start.GetLine(), start.GetColumn());
+		auto lastIndex = GetIndexFromColumn(start.GetLine(), end.GetColumn());
+		return GetLine(start.GetLine()).substr(firstIndex, lastIndex - firstIndex);
 	}
 	//Vertical text selection
 	else if (selection.IsVertical())
@@ -149,10 +329,9 @@ std::string Document::GetSelectedText() const
 		{
 			if (line > start.GetLine())
 				out << std::endl;
-			const auto& text = lines[line];
-			auto firstIndex = CalculateIndexFromColumn(text, firstColumn);
-			auto lastIndex = CalculateIndexFromColumn(text, lastColumn);
-			out << text.substr(firstIndex, lastIndex - firstIndex);
+			auto firstIndex = GetIndexFromColumn(line, firstColumn);
+			auto lastIndex = GetIndexFromColumn(line, lastColumn);
+			out << GetLine(line).substr(firstIndex, lastIndex - firstIndex);
 		}
 		return out.str();
 	}
@@ -162,13 +341,13 @@ std::string Document::GetSelectedText() const
 		std::ostringstream out;
 		for (auto line = start.GetLine(); line <= end.GetLine(); ++line)
 		{
-			const auto& text = lines[line];
+			const auto& text = GetLine(line);
 			if (line == start.GetLine())
-				out << text.substr(CalculateIndexFromColumn(text, start.GetColumn()));
+				out << text.substr(GetIndexFromColumn(line, start.GetColumn()));
 			else if (line != end.GetLine())
 				out << std::endl << text;
 			else
-				out << std::endl << text.substr(0, CalculateIndexFromColumn(text, end.GetColumn()));
+				out << std::endl << text.substr(0, GetIndexFromColumn(line, end.GetColumn()));
 		}
 		return out.str();
 	}
@@ -188,10 +367,11 @@ void Document::AtomicDeleteSelection()
 		if (start.GetColumn() == end.GetColumn())
 			return;
 
-		auto& line = lines[start.GetLine()];
-		auto firstIndex = CalculateIndexFromColumn(line, start.GetColumn());
-		auto lastIndex = CalculateIndexFromColumn(line, end.GetColumn());
+		auto firstIndex = GetIndexFromColumn(start.GetLine(), start.GetColumn());
+		auto lastIndex = GetIndexFromColumn(start.GetLine(), end.GetColumn());
+		auto line = GetLine(start.GetLine());
 		line.erase(firstIndex, lastIndex - firstIndex);
+		ReplaceLine(start.GetLine(), line);
 		selection.SetStart(start);
 		selection.SetEnd(start);
 	}
@@ -211,10 +391,11 @@ void Document::AtomicDeleteSelection()
 		//Remove vertical slice from each line from top to bottom
 		for (auto line = start.GetLine(); line <= end.GetLine(); ++line)
 		{
-			auto& text = lines[line];
-			auto firstIndex = CalculateIndexFromColumn(text, firstColumn);
-			auto lastIndex = CalculateIndexFromColumn(text, lastColumn);
+			auto firstIndex = GetIndexFromColumn(line, firstColumn);
+			auto lastIndex = GetIndexFromColumn(line, lastColumn);
+			auto text = GetLine(line);
 			text.erase(firstIndex, lastIndex - firstIndex);
+			ReplaceLine(line, text);
 		}
 		selection.SetStartColumn(firstColumn);
 		selection.SetEndColumn(firstColumn);
@@ -222,17 +403,18 @@ void Document::AtomicDeleteSelection()
 	//Normal multi-line text selection
 	else
 	{
-		auto& firstLine = lines[start.GetLine()];
+		const auto& firstLine = GetLine(start.GetLine());
 		auto firstLineIndex = CalculateIndexFromColumn(firstLine, start.GetColumn());
 		auto firstLinePrefix = firstLine.substr(0, firstLineIndex);
 
-		auto& lastLine = lines[end.GetLine()];
+		auto lastLine = GetLine(end.GetLine());
 		lastLine.erase(0, CalculateIndexFromColumn(lastLine, end.GetColumn()));
 		lastLine.insert(lastLine.begin(), firstLinePrefix.begin(), firstLinePrefix.end());
+		ReplaceLine(end.GetLine(), lastLine);
 
 		auto linesToDelete = end.GetLine() - start.GetLine();
 		if (linesToDelete > 0)
-			lines.erase(lines.begin() + start.GetLine(), lines.begin() + start.GetLine() + linesToDelete);
+			EraseLines(start.GetLine(), linesToDelete);
 
 		selection.SetStart(start);
 		selection.SetEnd(start);
@@ -275,13 +457,13 @@ void Document::AtomicInsertText(const std::string& value)
 			auto maxWidth = 0ul;
 			for (auto line = start.GetLine(); line <= end.GetLine(); ++line)
 			{
-				auto& text = lines[line];
-				auto columnWidth = CalculateColumnWidth(text);
-				if (start.GetColumn() > columnWidth)
+				if (start.GetColumn() > GetColumnWidth(line))
 					continue;
-				auto index = CalculateIndexFromColumn(text, start.GetColumn());
+				auto index = GetIndexFromColumn(line, start.GetColumn());
+				auto text = GetLine(line);
 				text.insert(text.begin() + index, insertedLines[0].begin(), insertedLines[0].end());
-				maxWidth = MATH::Max(maxWidth, CalculateColumnWidth(text.substr(0, index + insertedLines[0].size())));
+				ReplaceLine(line, text);
+				maxWidth = MATH::Max(maxWidth, GetColumnFromIndex(line, index + insertedLines[0].size()));
 			}
 			selection.SetStartColumn(maxWidth);
 			selection.SetEndColumn(maxWidth);
@@ -293,13 +475,16 @@ void Document::AtomicInsertText(const std::string& value)
 			auto line = start.GetLine();
 			for (const auto& insertedLine: insertedLines)
 			{
-				auto& text = lines[line++];
-				auto columnWidth = CalculateColumnWidth(text);
-				if (start.GetColumn() > columnWidth)
+				if (start.GetColumn() > GetColumnWidth(line))
+				{
+					++line;
 					continue;
-				auto index = CalculateIndexFromColumn(text, start.GetColumn());
+				}
+				auto index = GetIndexFromColumn(line, start.GetColumn());
+				auto text = GetLine(line);
 				text.insert(text.begin() + index, insertedLine.begin(), insertedLine.end());
-				maxWidth = MATH::Max(maxWidth, CalculateColumnWidth(text.substr(0, index + insertedLine.size())));
+				ReplaceLine(line, text);
+				maxWidth = MATH::Max(maxWidth, GetColumnFromIndex(line++, index + insertedLine.size()));
 			}
 			selection.SetStartColumn(maxWidth);
 			selection.SetEndColumn(maxWidth);
@@ -315,28 +500,32 @@ void Document::AtomicInsertText(const std::string& value)
 	{
 		if (insertedLines.size() == 1)
 		{
-			auto& text = lines[selection.GetStartLine()];
+			auto text = GetLine(selection.GetStartLine());
 			auto index = CalculateIndexFromColumn(text, selection.GetStartColumn());
 			text.insert(index, insertedLines[0]);
+			ReplaceLine(selection.GetStartLine(), text);
 			auto column = CalculateColumnWidth(text.substr(0, index + insertedLines[0].size()));
 			selection.SetStartColumn(column);
 			selection.SetEndColumn(column);
 		}
 		else if (insertedLines.size() > 1)
 		{
-			auto& firstLine = lines[selection.GetStartLine()];
+			auto firstLine = GetLine(selection.GetStartLine());
 			auto index = CalculateIndexFromColumn(firstLine, selection.GetStartColumn());
 			auto suffix = firstLine.substr(index);
 			firstLine.erase(firstLine.begin() + index, firstLine.end());
 			firstLine.insert(firstLine.end(), insertedLines[0].begin(), insertedLines[0].end());
+			ReplaceLine(selection.GetStartLine(), firstLine);
 
 			auto& lastLine = insertedLines.back();
 			auto column = CalculateColumnWidth(lastLine);
 			lastLine.insert(lastLine.end(), suffix.begin(), suffix.end());
 
-			lines.insert(lines.begin() + selection.GetStartLine() + 1, insertedLines.begin() + 1, insertedLines.end());
+			auto insertedLineCount = insertedLines.size();
+			insertedLines.erase(insertedLines.begin());
+			InsertLines(selection.GetStartLine() + 1, std::move(insertedLines));
 
-			DocumentPosition position(selection.GetStartLine() + insertedLines.size() - 1, column);
+			DocumentPosition position(selection.GetStartLine() + insertedLineCount - 1, column);
 			selection.SetStart(position);
 			selection.SetEnd(position);
 		}
@@ -345,42 +534,111 @@ void Document::AtomicInsertText(const std::string& value)
 
 bool Document::CanUndo() const
 {
-	return !undoBuffer.empty();
+	return undoJournal.CanUndo();
 }
 
 void Document::Undo()
 {
-	if (!undoBuffer.empty())
+	if (undoJournal.CanUndo())
 	{
-		auto action = undoBuffer.top();
+		//An edit of several selections is undone as a whole (the last action knows the selections)
+		auto action = undoJournal.Undo();
+		auto originalSelections = action.GetOriginalSelections();
 		action.Undo(this);
-		redoBuffer.push(action);
-		undoBuffer.pop();
+		while (action.IsJoined() && undoJournal.CanUndo())
+		{
+			action = undoJournal.Undo();
+			action.Undo(this);
+		}
+		if (!action.IsJoined())
+			RestoreSelections(originalSelections);
 		RaiseEvents();
 	}
 }
 
 bool Document::CanRedo() const
 {
-	return !redoBuffer.empty();
+	return undoJournal.CanRedo();
 }
 
 void Document::Redo()
 {
-	if (!redoBuffer.empty())
+	if (undoJournal.CanRedo())
 	{
-		auto action = redoBuffer.top();
+		auto action = undoJournal.Redo();
 		action.Redo(this);
-		undoBuffer.push(action);
-		redoBuffer.pop();
+		while (undoJournal.IsRedoJoined())
+		{
+			action = undoJournal.Redo();
+			action.Redo(this);
+		}
+		RestoreSelections(action.GetFinalSelections());
 		RaiseEvents();
 	}
 }
 
+Document::Transaction::Transaction(Document& document)
+	: document(document)
+{
+	document.BeginTransaction();
+}
+
+Document::Transaction::~Transaction()
+{
+	//The edits made so far are kept and undone as one, an error raising the events cannot leave a destructor
+	try
+	{
+		document.CommitTransaction();
+	}
+	catch (...)
+	{
+	}
+}
+
+void Document::BeginTransaction()
+{
+	//Transactions nest, only the outermost one records the edits and raises the events
+	if (transactionDepth++ > 0)
+		return;
+	undoJournal.EndCoalescing();
+	transactionActionCount = 0;
+	transactionSelections = selections.GetSelections();
+}
+
+void Document::CommitTransaction()
+{
+	assert(transactionDepth > 0);
+	if (--transactionDepth > 0)
+		return;
+
+	//The actions are undone as one edit, the last one restores the selections
+	if (transactionActionCount > 0)
+	{
+		if (!transactionSelections.empty())
+			transactionAction.SetSelections(
+				transactionSelections,
+				selections.IsEmpty() ? std::vector<DocumentSelection>{ selection } : selections.GetSelections());
+		undoJournal.Record(transactionAction);
+		undoJournal.EndCoalescing();
+	}
+	transactionSelections.clear();
+	RaiseEvents();
+}
+
+bool Document::IsInTransaction() const
+{
+	return transactionDepth > 0;
+}
+
 void Document::InsertText(const std::string& value)
 {
-	if (value.empty())
+	if (value.empty() || IsOpening())
+		return;
+	if (selections.GetCount() > 1)
+	{
+		EditSelections([&]() { InsertText(value); });
 		return;
+	}
 
 	DocumentAction action;
 	action.SetOriginalSelection(selection);
@@ -394,7 +652,7 @@ void Document::InsertText(const std::string& value)
 
 	if (value == "}" &&
 		emptyNonVerticalSelectionAfterFirstLine &&
-		STRING::trim(lines[selection.GetEndLine()]).empty())
+		STRING::trim(GetLine(selection.GetEndLine())).empty())
 	{
 		//Move select from current position to the correct indentation as determined by the correct
 		//indentation of the previous line ending in { without a matching line beginning with }.
@@ -403,7 +661,7 @@ void Document::InsertText(const std::string& value)
 		for (auto line = selection.GetEndLine(); line > 0; )
 		{
 			--line;
-			const auto& text = lines[line];
+			const auto& text = GetLine(line);
 			auto lastPosition = text.find_last_not_of("\t ");
 			auto firstPosition = text.find_first_not_of("\t ");
 			if (lastPosition != std::string::npos && text[lastPosition] == '{')
@@ -426,9 +684,9 @@ void Document::InsertText(const std::string& value)
 	//Move case labels (including default) to the indentation of the previous switch statement.
 	if (value == ":" &&
 		emptyNonVerticalSelectionAfterFirstLine &&
-		selection.GetEndColumn() == CalculateColumnWidth(lines[selection.GetEndLine()]))
+		selection.GetEndColumn() == CalculateColumnWidth(GetLine(selection.GetEndLine())))
 	{
-		auto firstWord = FindFirstWordOfLine(lines[selection.GetEndLine()]);
+		auto firstWord = FindFirstWordOfLine(GetLine(selection.GetEndLine()));
 		std::string matchStatement;
 		if (firstWord == "case" || firstWord == "default")
 			matchStatement = "switch";
@@ -441,16 +699,16 @@ void Document::InsertText(const std::string& value)
 			for (auto line = selection.GetEndLine(); line > 0; )
 			{
 				--line;
-				if (FindFirstWordOfLine(lines[line]) == matchStatement)
+				if (FindFirstWordOfLine(GetLine(line)) == matchStatement)
 				{
 					foundStatement = true;
-					statementIndent = CalculateIndentOfLine(lines[line]);
+					statementIndent = CalculateIndentOfLine(GetLine(line));
 					break;
 				}
 			}
 			if (foundStatement)
 			{
-				textInserted = CreateIndent(statementIndent) + STRING::trim(lines[selection.GetEndLine()]) + value;
+				textInserted = CreateIndent(statementIndent) + STRING::trim(GetLine(selection.GetEndLine())) + value;
 				selection.SetStartColumn(0);
 				selection.SetVertical(false);
 			}
@@ -470,6 +728,13 @@ void Document::InsertText(const std::string& value)
 
 void Document::PerformTab(bool shift)
 {
+	if (IsOpening())
+		return;
+	if (selections.GetCount() > 1)
+	{
+		EditSelections([&]() { PerformTab(shift); });
+		return;
+	}
 	//Decrease indentation
 	if (shift)
 	{
@@ -492,14 +757,14 @@ void Document::PerformTab(bool shift)
 			insertionSelection.SetStartColumn(0);
 			if (insertionSelection.GetEndColumn() != 0)
 			{
-				if (insertionSelection.GetEndLine() < (lines.size() - 1))
+				if (insertionSelection.GetEndLine() < (GetLineCount() - 1))
 				{
 					insertionSelection.SetEndLine(insertionSelection.GetEndLine() + 1);
 					insertionSelection.SetEndColumn(0);
 				}
 				else
 				{
-					insertionSelection.SetEndColumn(CalculateColumnWidth(lines.back()));
+					insertionSelection.SetEndColumn(CalculateColumnWidth(GetLine(GetLineCount() - 1)));
 				}
 			}
 			insertionSelection.SetVertical(false);
@@ -562,7 +827,7 @@ void Document::PerformTab(bool shift)
 			DocumentAction action;
 			action.SetOriginalSelection(selection);
 
-			auto text = lines[selection.GetEndLine()];
+			auto text = GetLine(selection.GetEndLine());
 			auto index = CalculateIndexFromColumn(text, selection.GetEndColumn());
 			auto columnWidth = CalculateColumnWidth(text);
 			auto column = selection.GetEndColumn();
@@ -660,10 +925,10 @@ void Document::PerformTab(bool shift)
 			AtomicInsertText(textInserted);
 			action.SetSelectionAfterInsert(selection);
 
-			if (insertionSelection.GetEndLine() < (lines.size() - 1))
+			if (insertionSelection.GetEndLine() < (GetLineCount() - 1))
 				insertionSelection.SetEndLine(insertionSelection.GetEndLine() + 1);
 			else
-				insertionSelection.SetEndColumn(CalculateColumnWidth(lines.back()));
+				insertionSelection.SetEndColumn(CalculateColumnWidth(GetLine(GetLineCount() - 1)));
 
 			selection.SetVertical(false);
 			selection.SetStart(inverted ? insertionSelection.GetEnd() : insertionSelection.GetStart());
@@ -676,6 +941,13 @@ void Document::PerformTab(bool shift)
 
 void Document::PerformDelete()
 {
+	if (IsOpening())
+		return;
+	if (selections.GetCount() > 1)
+	{
+		EditSelections([&]() { PerformDelete(); });
+		return;
+	}
 	//Delete the selected text
 	if (HasSelectedText())
 	{
@@ -700,7 +972,7 @@ void Document::PerformDelete()
 		if (lastLine < firstLine)
 			std::swap(firstLine, lastLine);
 		for (auto line = firstLine; line <= lastLine; ++line)
-			maxWidth = CalculateColumnWidth(lines[line]);
+			maxWidth = GetColumnWidth(line);
 		if (selection.GetStartColumn() < maxWidth)
 		{
 			DocumentAction action;
@@ -723,15 +995,15 @@ void Document::PerformDelete()
 	else
 	{
 		//Ignore delete key presses at the end of the file.
-		auto lastLine = lines.size() - 1;
-		auto lastLineWidth = CalculateColumnWidth(lines.back());
+		auto lastLine = GetLineCount() - 1;
+		auto lastLineWidth = GetColumnWidth(lastLine);
 		if (selection.GetStartLine() < lastLine || selection.GetStartColumn() < lastLineWidth)
 		{
 			DocumentAction action;
 			action.SetOriginalSelection(selection);
 
 			//Select the next character
-			const auto& text = lines[selection.GetStartLine()];
+			const auto& text = GetLine(selection.GetStartLine());
 			auto width = CalculateColumnWidth(text);
 			auto index = CalculateIndexFromColumn(text, selection.GetStartColumn());
 			if (width == selection.GetStartColumn())
@@ -761,6 +1033,13 @@ void Document::PerformDelete()
 
 void Document::PerformBackspace()
 {
+	if (IsOpening())
+		return;
+	if (selections.GetCount() > 1)
+	{
+		EditSelections([&]() { PerformBackspace(); });
+		return;
+	}
 	//Delete the selected text
 	if (HasSelectedText())
 	{
@@ -810,13 +1089,13 @@ void Document::PerformBackspace()
 			if (selection.GetStartColumn() == 0)
 			{
 				selection.SetEndLine(selection.GetStartLine() - 1);
-				selection.SetEndColumn(CalculateColumnWidth(lines[selection.GetEndLine()]));
+				selection.SetEndColumn(GetColumnWidth(selection.GetEndLine()));
 				selection.SetVertical(false);
 			}
 			else
 			{
-				auto index = CalculateIndexFromColumn(lines[selection.GetStartLine()], selection.GetStartColumn());
-				auto column = CalculateColumnWidth(lines[selection.GetStartLine()].substr(0, index - 1));
+				auto index = GetIndexFromColumn(selection.GetStartLine(), selection.GetStartColumn());
+				auto column = GetColumnFromIndex(selection.GetStartLine(), index - 1);
 				selection.SetEndColumn(column);
 				selection.SetVertical(false);
 			}
@@ -835,6 +1114,13 @@ void Document::PerformBackspace()
 
 void Document::InsertNewLine()
 {
+	if (IsOpening())
+		return;
+	if (selections.GetCount() > 1)
+	{
+		EditSelections([&]() { InsertNewLine(); });
+		return;
+	}
 	DocumentAction action;
 	action.SetOriginalSelection(selection);
 
@@ -852,7 +1138,7 @@ void Document::InsertNewLine()
 		selection.SetEnd(selection.GetStart());
 		selection.SetStart(oldEnd);
 	}
-	const auto& firstLine = lines[selection.GetStartLine()];
+	const auto& firstLine = GetLine(selection.GetStartLine());
 	auto index = CalculateIndexFromColumn(firstLine, selection.GetStartColumn());
 	while (index > 0 && std::isspace(firstLine[index - 1]))
 		--index;
@@ -872,7 +1158,7 @@ void Document::InsertNewLine()
 	for (auto line = firstLineToSearchBackFrom; line > 0; )
 	{
 		--line;
-		const auto& text = lines[line];
+		const auto& text = GetLine(line);
 		if (STRING::trim(text).empty())
 			continue;
 		indentation = CalculateColumnWidth(text.substr(0, text.find_first_not_of("\t ")));
@@ -898,29 +1184,33 @@ void Document::InsertNewLine()
 
 void Document::Tabify()
 {
+	if (IsOpening())
+		return;
+	ClearSelections();
 	DocumentAction action;
 	action.SetOriginalSelection(selection);
 	auto cursorPosition = selection.GetEnd();
 
 	selection.SetStartLine(0);
 	selection.SetStartColumn(0);
-	selection.SetEndLine(lines.size() - 1);
-	selection.SetEndColumn(CalculateColumnWidth(lines.back()));
+	selection.SetEndLine(GetLineCount() - 1);
+	selection.SetEndColumn(CalculateColumnWidth(GetLine(GetLineCount() - 1)));
 	selection.SetVertical(false);
 	action.SetSelectionBeforeDelete(selection);
 	action.SetTextDeleted(GetSelectedText());
 
-	for (auto& text: lines)
+	for (auto line = 0ul; line < GetLineCount(); ++line)
 	{
+		const auto& text = GetLine(line);
 		auto firstPosition = text.find_first_not_of("\t ");
 		if (firstPosition == std::string::npos)
 		{
 			if (!text.empty())
-				text = CreateIndent((CalculateColumnWidth(text) / 4) * 4);
+				ReplaceLine(line, CreateIndent((CalculateColumnWidth(text) / 4) * 4));
 		}
 		else if (firstPosition > 0)
 		{
-			text = CreateIndent((CalculateColumnWidth(text.substr(0, firstPosition)) / 4) * 4) + text.substr(firstPosition);
+			ReplaceLine(line, CreateIndent((CalculateColumnWidth(text.substr(0, firstPosition)) / 4) * 4) + text.substr(firstPosition));
 		}
 	}
 
@@ -930,8 +1220,8 @@ void Document::Tabify()
 	selection.SetEndColumn(0);
 	action.SetSelectionBeforeInsert(selection);
 
-	selection.SetEndLine(lines.size() - 1);
-	selection.SetEndColumn(CalculateColumnWidth(lines.back()));
+	selection.SetEndLine(GetLineCount() - 1);
+	selection.SetEndColumn(CalculateColumnWidth(GetLine(GetLineCount() - 1)));
 	action.SetSelectionAfterInsert(selection);
 
 	selection.SetStart(cursorPosition);
@@ -942,6 +1232,9 @@ void Document::Tabify()
 
 void Document::InsertFileHeader()
 {
+	if (IsOpening())
+		return;
+	ClearSelections();
 	DocumentAction action;
 	action.SetOriginalSelection(selection);
 	selection.SetStartLine(0);
@@ -961,6 +1254,9 @@ void Document::InsertFileHeader()
 
 void Document::InsertOneTimeInclude()
 {
+	if (IsOpening())
+		return;
+	ClearSelections();
 	DocumentAction action;
 	action.SetOriginalSelection(selection);
 	selection.SetStartLine(0);
@@ -980,15 +1276,26 @@ void Document::InsertOneTimeInclude()
 
 void Document::SelectPosition(const DocumentPosition& position, bool extend, bool isVertical)
 {
+	ClearSelections();
+
 	//Region start/end define the region that needs to be redrawn
 	auto regionStart = selection.GetStart();
 	auto regionEnd = selection.GetEnd();
+	auto wasVertical = selection.IsVertical();
 
 	//Set the new end to be the given position and update the vertical text selection flag
 	selection.SetEnd(position);
 	selection.SetVertical(isVertical);
 
-	if (extend)
+	if (extend && (isVertical || wasVertical))
+	{
+		//A vertical selection changes its columns on every line, so redraw the old and new selection
+		auto first = std::min({ regionStart, regionEnd, position });
+		auto last = std::max({ regionStart, regionEnd, position });
+		regionStart = first;
+		regionEnd = last;
+	}
+	else if (extend)
 	{
 		//The redraw region only need to extend from the previous end to the new position
 		regionStart = position;
@@ -1024,13 +1331,13 @@ void Document::SelectPreviousCharacter(bool extend, bool isVertical)
 		if (line > 0)
 		{
 			--line;
-			column = CalculateColumnWidth(lines[line]);
+			column = GetColumnWidth(line);
 		}
 	}
 	else
 	{
-		auto index = CalculateIndexFromColumn(lines[line], column);
-		column = CalculateColumnWidth(lines[line].substr(0, index - 1));
+		auto index = GetIndexFromColumn(line, column);
+		column = GetColumnFromIndex(line, index - 1);
 	}
 
 	SelectPosition(DocumentPosition(line, column), extend, isVertical);
@@ -1040,11 +1347,11 @@ void Document::SelectNextCharacter(bool extend, bool isVertical)
 {
 	auto line = selection.GetEndLine();
 	auto column = selection.GetEndColumn();
-	auto columnWidth = CalculateColumnWidth(lines[line]);
+	auto columnWidth = GetColumnWidth(line);
 
 	if (column == columnWidth)
 	{
-		if ((line + 1) < lines.size())
+		if ((line + 1) < GetLineCount())
 		{
 			++line;
 			column = 0;
@@ -1052,8 +1359,8 @@ void Document::SelectNextCharacter(bool extend, bool isVertical)
 	}
 	else
 	{
-		auto index = CalculateIndexFromColumn(lines[line], column);
-		column = CalculateNextColumn(lines[line][index], column);
+		auto index = GetIndexFromColumn(line, column);
+		column = CalculateNextColumn(GetLine(line)[index], column);
 	}
 
 	SelectPosition(DocumentPosition(line, column), extend, isVertical);
@@ -1063,8 +1370,7 @@ void Document::SelectPreviousWord(bool extend, bool isVertical, bool skipWhitesp
 {
 	auto line = selection.GetEndLine();
 	auto column = selection.GetEndColumn();
-	auto columnWidth = CalculateColumnWidth(lines[line]);
-	auto index = column == columnWidth ? lines[line].size() : CalculateIndexFromColumn(lines[line], column);
+	auto index = GetIndexFromColumn(line, column);
 
 	//Skip to the end of the previous line if at the beginning of the currnet line
 	if (index == 0 && skipWhitespace)
@@ -1072,11 +1378,11 @@ void Document::SelectPreviousWord(bool extend, bool isVertical, bool skipWhitesp
 		if (line > 0)
 		{
 			--line;
-			index = lines[line].size();
+			index = GetLine(line).size();
 		}
 	}
 
-	const auto& text = lines[line];
+	const auto& text = GetLine(line);
 
 	//Skip backwards over whitespace
 	while (skipWhitespace && index > 0 && std::isspace(text[index - 1]))
@@ -1098,7 +1404,7 @@ void Document::SelectPreviousWord(bool extend, bool isVertical, bool skipWhitesp
 		}
 	}
 
-	column = CalculateColumnWidth(text.substr(0, index));
+	column = GetColumnFromIndex(line, index);
 	SelectPosition(DocumentPosition(line, column), extend, isVertical);
 }
 
@@ -1106,17 +1412,17 @@ void Document::SelectNextWord(bool extend, bool isVertical, bool skipWhitespace)
 {
 	auto line = selection.GetEndLine();
 	auto column = selection.GetEndColumn();
-	auto columnWidth = CalculateColumnWidth(lines[line]);
+	auto columnWidth = GetColumnWidth(line);
 
 	//Skip to the beginning of the next line if we are at the end of the current line
-	if (column == columnWidth && (line + 1) < lines.size())
+	if (column == columnWidth && (line + 1) < GetLineCount())
 	{
 		++line;
 		column = 0;
 	}
 
-	const auto& text = lines[line];
-	auto index = CalculateIndexFromColumn(text, column);
+	const auto& text = GetLine(line);
+	auto index = GetIndexFromColumn(line, column);
 	auto advanceIndex = [&]()
 	{
 		column = CalculateNextColumn(text[index], column);
@@ -1160,8 +1466,8 @@ void Document::SelectLine(long delta, bool extend, bool isVertical)
 {
 	auto line = selection.GetEndLine();
 	auto column = selection.GetEndColumn();
-	line = MATH::Bound(0, static_cast<long>(lines.size() - 1), static_cast<long>(line) + delta);
-	column = MATH::Bound(0ul, CalculateColumnWidth(lines[line]), column);
+	line = MATH::Bound(0, static_cast<long>(GetLineCount() - 1), static_cast<long>(line) + delta);
+	column = MATH::Bound(0ul, GetColumnWidth(line), column);
 	SelectPosition(DocumentPosition(line, column), extend, isVertical);
 }
 
@@ -1169,8 +1475,8 @@ void Document::SelectStartOfLine(bool extend, bool isVertical)
 {
 	auto line = selection.GetEndLine();
 	auto column = selection.GetEndColumn();
-	auto firstNonSpace = lines[line].find_first_not_of(" \t");
-	auto leadingSpaceWidth = firstNonSpace == std::string::npos ? 0 : CalculateColumnWidth(lines[line].substr(0, firstNonSpace));
+	auto firstNonSpace = GetLine(line).find_first_not_of(" \t");
+	auto leadingSpaceWidth = firstNonSpace == std::string::npos ? 0 : GetColumnFromIndex(line, firstNonSpace);
 	if (column == leadingSpaceWidth || firstNonSpace == std::string::npos)
 		column = 0;
 	else
@@ -1181,7 +1487,7 @@ void Document::SelectStartOfLine(bool extend, bool isVertical)
 void Document::SelectEndOfLine(bool extend, bool isVertical)
 {
 	auto line = selection.GetEndLine();
-	auto lastColumn = CalculateColumnWidth(lines[line]);
+	auto lastColumn = GetColumnWidth(line);
 	SelectPosition(DocumentPosition(line, lastColumn), extend, isVertical);
 }
 
@@ -1193,10 +1499,56 @@ void Document::SelectStartOfFile(bool extend, bool isVertical)
 
 void Document::SelectEndOfFile(bool extend, bool isVertical)
 {
-	DocumentPosition position(lines.size() - 1, CalculateColumnWidth(lines.back()));
+	DocumentPosition position(GetLineCount() - 1, GetColumnWidth(GetLineCount() - 1));
 	SelectPosition(position, extend, isVertical);
 }
 
+const DocumentSelectionSet& Document::GetSelections() const
+{
+	return selections;
+}
+
+void Document::AddSelection(const DocumentSelection& value)
+{
+	//The current selection becomes the first of several, and the one added becomes current
+	if (selections.IsEmpty())
+		selections.Add(selection);
+	selections.Add(value);
+	selection = selections.Get(selections.Find(value.GetEnd()));
+	if (selections.GetCount() < 2)
+		selections.Clear();
+	events->OnDocumentEditRegion(value.GetStart(), value.GetEnd());
+	events->OnDocumentSelectionChanged();
+}
+
+void Document::SelectMatches(const DocumentSearch& search)
+{
+	auto matches = FindMatches(search, 0, GetLineCount());
+	if (matches.empty())
+		return;
+
+	//The match at (or after) the caret stays current so the view does not jump
+	ClearSelections();
+	auto caret = selection.GetEnd();
+	for (const auto& match: matches)
+	{
+		DocumentSelection value;
+		value.SetStart({ match.line, match.firstColumn });
+		value.SetEnd({ match.line, match.lastColumn });
+		selections.Add(value);
+	}
+	auto index = selections.FindFirstOnLine(caret.GetLine());
+	while (index < selections.GetCount() && DocumentSelectionSet::GetLast(selections.Get(index)) < caret)
+		++index;
+	selection = selections.Get(MATH::Min(index, selections.GetCount() - 1));
+	auto first = DocumentSelectionSet::GetFirst(selections.Get(0));
+	auto last = DocumentSelectionSet::GetLast(selections.Get(selections.GetCount() - 1));
+	if (selections.GetCount() < 2)
+		selections.Clear();
+	events->OnDocumentEditRegion(first, last);
+	events->OnDocumentSelectionChanged();
+}
+
 void Document::ToggleBookmark()
 {
 	auto line = selection.GetEndLine();
@@ -1234,34 +1586,107 @@ bool Document::IsLineBookmarked(unsigned long index) const
 	return bookmarks.find(index) != bookmarks.end();
 }
 
-void Document::FindTextInDocument(const std::string& text, OutputTarget* outputTarget)
+std::vector<DocumentSearch::Match> Document::FindMatches(const DocumentSearch& search, unsigned long firstLine, unsigned long lastLine) const
 {
+	std::vector<DocumentSearch::Match> matches;
+	lastLine = MATH::Min(lastLine, GetLineCount());
+	for (auto line = firstLine; line < lastLine; ++line)
+	{
+		//Lines are searched in place so a mapped file is not copied, only lines with a match
+		//are materialized (for their layout).
+		auto firstMatch = matches.size();
+		unsigned long length = 0;
+		auto text = storage->GetLineText(line, length);
+		search.FindInLine(line, text, length, matches);
+		if (firstMatch == matches.size())
+			continue;
+
+		//Matches are found by index, the view also needs to know where they are drawn
+		const auto& layout = GetLineLayout(line);
+		for (auto index = firstMatch; index < matches.size(); ++index)
+		{
+			auto& match = matches[index];
+			match.firstColumn = layout.GetColumnFromIndex(match.index);
+			match.lastColumn = layout.GetColumnFromIndex(match.index + match.length);
+		}
+	}
+	return matches;
+}
+
+void Document::FindTextInDocument(const DocumentSearch& search, OutputTarget* outputTarget)
+{
+	//Starting a new query cancels the previous one (its results may be reused to narrow this one)
+	find.Start(search, editVersion);
+	findOutputTarget = outputTarget;
 	if (outputTarget == nullptr || fileName.empty())
+	{
+		find.Stop();
 		return;
+	}
 
-	auto count = 0ul;
-	const auto& fileName = relativeFileName;
 	outputTarget->Clear();
+	if (search.IsEmpty())
+		return;
 
-	if (text.empty())
+	if (!search.IsValid())
+	{
+		outputTarget->Append("Invalid regular expression '" + search.GetPattern() + "'.\r\n");
 		return;
+	}
 
+	outputTarget->Append("Find results for '" + search.GetPattern() + "' in '" + relativeFileName + "'.\r\n");
+	UpdateFind();
+}
+
+bool Document::IsFinding() const
+{
+	return find.IsRunning();
+}
+
+void Document::UpdateFind()
+{
+	if (!find.IsRunning())
+		return;
+
+	Trace::Span trace("find");
+	//Edits move lines around, so the results so far are thrown away and the find starts over
+	if (find.GetVersion() != editVersion)
+	{
+		auto search = find.GetSearch();
+		FindTextInDocument(search, findOutputTarget);
+		return;
+	}
+
+	//Search until the time slice is used up and deliver what was found as one chunk
 	std::ostringstream out;
-	out << "Find results for '" << text << "' in '" << fileName << "'." << std::endl;
+	auto start = std::chrono::steady_clock::now();
+	auto line = 0ul;
+	for (auto searched = 1ul; find.NextLine(GetLineCount(), line); ++searched)
+	{
+		auto matches = FindMatches(find.GetSearch(), line, line + 1);
+		for (const auto& match: matches)
+			out << "0> " << relativeFileName << ":" << (match.line + 1) << ":" << (match.index + 1) << ": " << GetLine(match.line) << std::endl;
+		if (!matches.empty())
+			find.AddMatches(line, matches.size());
+		if (searched % findClockInterval == 0 && std::chrono::steady_clock::now() - start >= findTimeSlice)
+			break;
+	}
 
-	for (auto index = 0ul; index < lines.size(); ++index)
+	//Lines still being streamed in are searched as they arrive
+	if (find.IsDone(GetLineCount()) && !IsOpening())
 	{
-		const auto& line = lines[index];
-		auto iter = std::search(line.begin(), line.end(), text.begin(), text.end(), STRING::iequal_char());
-		if (iter != line.end())
-		{
-			out << "0> " << fileName << ":" << (index + 1) << ":" << ((iter - line.begin()) + 1) << ": " << line << std::endl;
-			++count;
-		}
+		find.Stop();
+		out << find.GetMatchCount() << " occurrence(s) found." << std::endl;
 	}
 
-	out << count << " occurrence(s) found." << std::endl;
-	outputTarget->Append(STRING::replace(out.str(), "\n", "\r\n"));
+	auto chunk = out.str();
+	if (!chunk.empty())
+		findOutputTarget->Append(STRING::replace(chunk, "\n", "\r\n"));
+}
+
+void Document::CancelFind()
+{
+	find.Stop();
 }
 
 unsigned long Document::CalculateColumnWidth(const std::string& line)
@@ -1316,18 +1741,239 @@ std::string Document::FindFirstWordOfLine(const std::string& value)
 		value.substr(firstPosition, nextPosition - firstPosition);
 }
 
+void Document::ReplaceLine(unsigned long index, const std::string& value)
+{
+	lexerThread.reset();
+	RemoveLineWidth(GetLine(index));
+	AddLineWidth(value);
+	storage->ReplaceLine(index, value);
+	lexerCache.ChangeLine(index);
+	damage.Add(index, 1, 1);
+	++editVersion;
+}
+
+void Document::InsertLines(unsigned long index, std::vector<std::string>&& values)
+{
+	lexerThread.reset();
+	for (const auto& value: values)
+		AddLineWidth(value);
+	auto count = values.size();
+	storage->InsertLines(index, std::move(values));
+	lexerCache.InsertLines(index, count);
+	damage.Add(index, 0, count);
+	++editVersion;
+}
+
+void Document::EraseLines(unsigned long index, unsigned long count)
+{
+	lexerThread.reset();
+	for (auto line = index; line < index + count; ++line)
+		RemoveLineWidth(GetLine(line));
+	storage->EraseLines(index, count);
+	lexerCache.EraseLines(index, count);
+	damage.Add(index, count, 0);
+	++editVersion;
+}
+
+void Document::AddLineWidth(const std::string& line)
+{
+	++lineWidthCounts[line.size()];
+}
+
+void Document::RemoveLineWidth(const std::string& line)
+{
+	auto iter = lineWidthCounts.find(line.size());
+	assert(iter != lineWidthCounts.end());
+	if (--iter->second == 0)
+		lineWidthCounts.erase(iter);
+}
+
+const DocumentLineLayout& Document::GetLineLayout(unsigned long line) const
+{
+	//Stored text is never modified in place or freed before the storage is loaded again, so the
+	//address of a line's text identifies it and only an edit to the line (which stores new text)
+	//needs a new layout.  The text of a mapped line is read from the view so it is not cached.
+	unsigned long length = 0;
+	auto text = storage->GetLineText(line, length);
+	auto iter = lineLayouts.find(text);
+	if (iter == lineLayouts.end())
+	{
+		Trace::Span trace("layout");
+		if (lineLayouts.size() >= maxLineLayouts)
+			lineLayouts.clear();
+		iter = lineLayouts.insert({ text, DocumentLineLayout(std::string(text, length)) }).first;
+	}
+	return iter->second;
+}
+
+unsigned long Document::GetIndexFromColumn(unsigned long line, unsigned long column) const
+{
+	return GetLineLayout(line).GetIndexFromColumn(column);
+}
+
+unsigned long Document::GetColumnFromIndex(unsigned long line, unsigned long index) const
+{
+	return GetLineLayout(line).GetColumnFromIndex(index);
+}
+
+std::vector<std::string> Document::CopyLines() const
+{
+	std::vector<std::string> lines;
+	lines.reserve(GetLineCount());
+	for (auto index = 0ul; index < GetLineCount(); ++index)
+		lines.push_back(GetLine(index));
+	return lines;
+}
+
+void Document::LoadSavedFile(const std::string& savedFileName)
+{
+	//Saved lines keep their trailing whitespace, so only the line endings are stripped
+	//The storage is only replaced once the file has been mapped and indexed
+	std::unique_ptr<DocumentMappedFile> file(new DocumentMappedFile());
+	if (!file->Open(savedFileName, 0, false))
+		throw std::runtime_error{ "Could not map saved file: " + savedFileName };
+	file->IndexChunk(std::numeric_limits<unsigned long>::max());
+	storage->Load(std::move(file));
+}
+
+void Document::EditSelections(const std::function<void()>& edit)
+{
+	//The selections are edited one at a time from the bottom of the document up, so the ones
+	//still to be edited never move.  The ones already edited move with the lines inserted or
+	//removed above them and keep their distance from the end of their line, since an edit on
+	//the same line is always to their left.  Positions are kept as (line, index from the end).
+	auto originalSelections = selections.GetSelections();
+	auto primary = MATH::Min(selections.Find(selection.GetEnd()), selections.GetCount() - 1);
+	Transaction transaction(*this);
+	selections.Clear();
+
+	auto toLineEnd = [&](const DocumentPosition& position)
+	{
+		auto line = position.GetLine();
+		return DocumentPosition(line, GetLine(line).size() - GetIndexFromColumn(line, position.GetColumn()));
+	};
+	std::vector<std::pair<DocumentPosition, DocumentPosition>> edited;
+	for (auto index = originalSelections.size(); index > 0; )
+	{
+		selection = originalSelections[--index];
+		auto actionCount = transactionActionCount;
+		edit();
+		if (transactionActionCount != actionCount)
+		{
+			auto deleteEnd = DocumentSelectionSet::GetLast(transactionAction.GetSelectionBeforeDelete());
+			auto insertEnd = toLineEnd(DocumentSelectionSet::GetLast(transactionAction.GetSelectionAfterInsert()));
+			auto move = [&](DocumentPosition& position)
+			{
+				if (position.GetLine() > deleteEnd.GetLine())
+					position.SetLine(position.GetLine() - deleteEnd.GetLine() + insertEnd.GetLine());
+				else if (position.GetLine() < deleteEnd.GetLine() || position.GetColumn() > insertEnd.GetColumn())
+					position = insertEnd;
+				else
+					position.SetLine(insertEnd.GetLine());
+			};
+			for (auto& positions: edited)
+			{
+				move(positions.first);
+				move(positions.second);
+			}
+		}
+		edited.push_back({ toLineEnd(selection.GetStart()), toLineEnd(selection.GetEnd()) });
+	}
+
+	//The edits can bring selections together, those are merged again
+	auto toColumn = [&](const DocumentPosition& position)
+	{
+		auto line = position.GetLine();
+		return DocumentPosition(line, GetColumnFromIndex(line, GetLine(line).size() - position.GetColumn()));
+	};
+	std::vector<DocumentSelection> finalSelections;
+	for (auto iter = edited.rbegin(); iter != edited.rend(); ++iter)
+	{
+		DocumentSelection value;
+		value.SetStart(toColumn(iter->first));
+		value.SetEnd(toColumn(iter->second));
+		finalSelections.push_back(value);
+	}
+	selection = finalSelections[primary];
+	RestoreSelections(finalSelections);
+}
+
+void Document::RestoreSelections(const std::vector<DocumentSelection>& values)
+{
+	//The current selection stays current when it is one of the restored selections
+	selections.Clear();
+	if (values.empty())
+		return;
+	for (const auto& value: values)
+		selections.Add(value);
+	if (selections.GetCount() < 2)
+	{
+		selection = selections.Get(0);
+		selections.Clear();
+		return;
+	}
+	auto index = selections.Find(selection.GetEnd());
+	selection = selections.Get(index < selections.GetCount() ? index : selections.GetCount() - 1);
+}
+
+void Document::ClearSelections()
+{
+	if (selections.IsEmpty())
+		return;
+
+	//The other selections are no longer drawn
+	auto first = DocumentSelectionSet::GetFirst(selections.Get(0));
+	auto last = DocumentSelectionSet::GetLast(selections.Get(selections.GetCount() - 1));
+	selections.Clear();
+	events->OnDocumentEditRegion(first, last);
+}
+
 void Document::RecordAction(const DocumentAction& action)
 {
-	undoBuffer.push(action);
-	while (!redoBuffer.empty())
-		redoBuffer.pop();
+	//A transaction holds back its latest action until it commits, the others are joined to it
+	if (transactionDepth > 0)
+	{
+		if (transactionActionCount > 0)
+			undoJournal.Record(transactionAction);
+		transactionAction = action;
+		transactionAction.SetJoined(transactionActionCount > 0);
+		++transactionActionCount;
+		return;
+	}
+	undoJournal.Record(action);
 	RaiseEvents();
 }
 
 void Document::RaiseEvents()
 {
-	events->OnDocumentSizeChanged();
+	//The damage of every edit in a transaction is reported once when it commits
+	if (transactionDepth > 0)
+		return;
+	RaiseSizeChanged();
+	if (!damage.IsEmpty())
+	{
+		//Lines after the edit change color when it opened or closed a block comment or raw string
+		auto endLine = damage.GetEndLine();
+		auto lexStart = Trace::Now();
+		auto recolorEnd = lexerCache.Settle(*storage, endLine, maxRecolorLines);
+		Trace::Record("lex", lexStart, Trace::Now());
+		if (recolorEnd > endLine)
+			damage.Add(endLine, recolorEnd - endLine, recolorEnd - endLine);
+		events->OnDocumentLinesChanged(damage);
+		damage.Clear();
+	}
 	events->OnDocumentEditRegion(selection.GetStart(), selection.GetEnd());
 	events->OnDocumentSelectionChanged();
 }
 
+void Document::RaiseSizeChanged()
+{
+	//Most edits neither add lines nor change the widest line, so the listener is not told
+	auto newMetrics = GetMetrics();
+	if (newMetrics == metrics)
+		return;
+	auto oldMetrics = metrics;
+	metrics = newMetrics;
+	events->OnDocumentSizeChanged(oldMetrics, newMetrics);
+}
+
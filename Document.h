@@ -14,34 +14,54 @@
 #pragma once
 #include <string>
 #include <vector>
-#include <stack>
+#include <map>
+#include <unordered_map>
+#include <memory>
+#include <functional>
 #include "DocumentSelection.h"
+#include "DocumentSelectionSet.h"
 #include "DocumentPosition.h"
 #include "DocumentAction.h"
+#include "DocumentUndoJournal.h"
 #include "DocumentEvents.h"
+#include "DocumentDamage.h"
+#include "DocumentMetrics.h"
 #include "DocumentOperations.h"
 #include "OutputTarget.h"
+#include "DocumentStorage.h"
+#include "DocumentIndexThread.h"
+#include "DocumentLineLayout.h"
+#include "DocumentLexerCache.h"
+#include "DocumentLexerThread.h"
+#include "DocumentSearch.h"
+#include "DocumentFind.h"
 
 class Document : public DocumentOperations
 {
 public:
-	Document() = default;
-	Document(const Document& rhs) = default;
+	Document();
+	Document(const Document& rhs) = delete;
 	~Document() = default;
 
-	Document& operator=(const Document& rhs) = default;
+	Document& operator=(const Document& rhs) = delete;
 
 	void Open(const std::string& fileName, const std::string& relativeFileName);
+	bool IsOpening() const;
+	void UpdateOpen();
 	const std::string& GetFileName() const;
 	void SetFileName(const std::string& value);
 	bool IsDirty() const;
 	void Save();
 	void SetEvents(DocumentEvents* events);
 	SIZE GetSize() const;
+	DocumentMetrics GetMetrics() const;
 	unsigned long GetMaxWidth() const;
 	unsigned long GetLineCount() const;
 	const std::string& GetLine(unsigned long index) const;
 	unsigned long GetColumnWidth(unsigned long index) const;
+	const std::vector<DocumentLexer::Run>& GetTokenRuns(unsigned long index) const;
+	bool IsLexing() const;
+	void UpdateLexer();
 	DocumentPosition HitTest(const DocumentPosition& position) const;
 	bool HasSelectedText() const;
 
@@ -56,6 +76,25 @@ public:
 	bool CanRedo() const;
 	void Redo();
 
+	//transaction functions
+	class Transaction
+	{
+	public:
+		//Commits when it goes out of scope, also when an edit inside of it throws
+		explicit Transaction(Document& document);
+		Transaction(const Transaction& rhs) = delete;
+		~Transaction();
+
+		Transaction& operator=(const Transaction& rhs) = delete;
+
+	private:
+		Document& document;
+	};
+
+	void BeginTransaction();
+	void CommitTransaction();
+	bool IsInTransaction() const;
+
 	//editing functions
 	void InsertText(const std::string& value);
 	void PerformTab(bool shift);
@@ -81,13 +120,22 @@ public:
 	void SelectStartOfFile(bool extend, bool isVertical);
 	void SelectEndOfFile(bool extend, bool isVertical);
 
+	//multiple selection functions
+	const DocumentSelectionSet& GetSelections() const;
+	void AddSelection(const DocumentSelection& value);
+	void SelectMatches(const DocumentSearch& search);
+
 	//bookmark functions
 	void ToggleBookmark();
 	void NextBookmark();
 	void PreviousBookmark();
 	bool IsLineBookmarked(unsigned long index) const;
 	
-	void FindTextInDocument(const std::string& text, OutputTarget* outputTarget);
+	std::vector<DocumentSearch::Match> FindMatches(const DocumentSearch& search, unsigned long firstLine, unsigned long lastLine) const;
+	void FindTextInDocument(const DocumentSearch& search, OutputTarget* outputTarget);
+	bool IsFinding() const;
+	void UpdateFind();
+	void CancelFind();
 
 private:
 	static unsigned long CalculateColumnWidth(const std::string& line);
@@ -97,17 +145,47 @@ private:
 	static std::string CreateIndent(unsigned long columnWidth);
 	static std::string FindFirstWordOfLine(const std::string& value);
 
+	void ReplaceLine(unsigned long index, const std::string& value);
+	void InsertLines(unsigned long index, std::vector<std::string>&& values);
+	void EraseLines(unsigned long index, unsigned long count);
+	void AddLineWidth(const std::string& line);
+	void RemoveLineWidth(const std::string& line);
+	const DocumentLineLayout& GetLineLayout(unsigned long line) const;
+	unsigned long GetIndexFromColumn(unsigned long line, unsigned long column) const;
+	unsigned long GetColumnFromIndex(unsigned long line, unsigned long index) const;
+	std::vector<std::string> CopyLines() const;
+	void LoadSavedFile(const std::string& savedFileName);
+
+	void EditSelections(const std::function<void()>& edit);
+	void RestoreSelections(const std::vector<DocumentSelection>& values);
+	void ClearSelections();
 	void RecordAction(const DocumentAction& action);
 	void RaiseEvents();
+	void RaiseSizeChanged();
 
 private:
 	std::string fileName;
 	std::string relativeFileName;
-	std::vector<std::string> lines;
-	std::stack<DocumentAction> undoBuffer;
-	std::stack<DocumentAction> redoBuffer;
+	std::unique_ptr<DocumentStorage> storage;
+	DocumentMappedFile* openingFile = nullptr;
+	DocumentIndexThreadPtr indexThread;
+	std::map<unsigned long, unsigned long> lineWidthCounts;
+	mutable std::unordered_map<const char*, DocumentLineLayout> lineLayouts;
+	mutable DocumentLexerCache lexerCache;
+	DocumentLexerThreadPtr lexerThread;
+	DocumentUndoJournal undoJournal;
 	std::set<unsigned long> bookmarks;
 	DocumentSelection selection;
+	DocumentSelectionSet selections;
+	DocumentAction transactionAction;
+	unsigned long transactionActionCount = 0;
+	unsigned long transactionDepth = 0;
+	std::vector<DocumentSelection> transactionSelections;
 	DocumentEvents* events = nullptr;
+	DocumentDamage damage;
+	DocumentMetrics metrics;
+	unsigned long editVersion = 0;
+	DocumentFind find;
+	OutputTarget* findOutputTarget = nullptr;
 };
 
@@ -10,6 +10,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 #include "pch.h"
 #include "DocumentAction.h"
+#include <cstring>
 
 void DocumentAction::Redo(DocumentOperations* target) const
 {
@@ -84,3 +85,169 @@ void DocumentAction::SetFinalSelection(const DocumentSelection& value)
 	finalSelection = value;
 }
 
+const DocumentSelection& DocumentAction::GetSelectionBeforeDelete() const
+{
+	return selectionBeforeDelete;
+}
+
+const DocumentSelection& DocumentAction::GetSelectionAfterInsert() const
+{
+	return selectionAfterInsert;
+}
+
+void DocumentAction::SetJoined(bool value)
+{
+	isJoined = value;
+}
+
+bool DocumentAction::IsJoined() const
+{
+	return isJoined;
+}
+
+void DocumentAction::SetSelections(const std::vector<DocumentSelection>& original, const std::vector<DocumentSelection>& final)
+{
+	originalSelections = original;
+	finalSelections = final;
+}
+
+const std::vector<DocumentSelection>& DocumentAction::GetOriginalSelections() const
+{
+	return originalSelections;
+}
+
+const std::vector<DocumentSelection>& DocumentAction::GetFinalSelections() const
+{
+	return finalSelections;
+}
+
+bool DocumentAction::Coalesce(const DocumentAction& next)
+{
+	if (!IsSingleLineEdit() || !next.IsSingleLineEdit() ||
+		!IsSamePosition(next.originalSelection.GetEnd(), finalSelection.GetEnd()))
+		return false;
+
+	//Typing a character immediately after the previously typed text
+	if (textDeleted.empty() &&
+		next.textDeleted.empty() &&
+		next.textInserted.size() == 1 &&
+		IsSamePosition(next.selectionBeforeInsert.GetEnd(), selectionAfterInsert.GetEnd()))
+	{
+		textInserted += next.textInserted;
+		selectionAfterInsert = next.selectionAfterInsert;
+		finalSelection = next.finalSelection;
+		return true;
+	}
+
+	//Backspacing over the character immediately before the previously deleted text
+	if (textInserted.empty() &&
+		next.textInserted.empty() &&
+		next.textDeleted.size() == 1 &&
+		selectionBeforeDelete.GetEnd() < selectionBeforeDelete.GetStart() &&
+		IsSamePosition(next.selectionBeforeDelete.GetStart(), selectionBeforeDelete.GetEnd()) &&
+		next.selectionBeforeDelete.GetEnd() < next.selectionBeforeDelete.GetStart())
+	{
+		textDeleted = next.textDeleted + textDeleted;
+		selectionBeforeDelete.SetEnd(next.selectionBeforeDelete.GetEnd());
+		selectionBeforeInsert = next.selectionBeforeInsert;
+		selectionAfterInsert = next.selectionAfterInsert;
+		finalSelection = next.finalSelection;
+		return true;
+	}
+
+	return false;
+}
+
+void DocumentAction::Write(std::vector<char>& buffer) const
+{
+	//Selections are plain values so they are copied as is, text is length prefixed
+	WriteBytes(buffer, &originalSelection, sizeof(originalSelection));
+	WriteBytes(buffer, &selectionBeforeDelete, sizeof(selectionBeforeDelete));
+	WriteBytes(buffer, &selectionBeforeInsert, sizeof(selectionBeforeInsert));
+	WriteBytes(buffer, &selectionAfterInsert, sizeof(selectionAfterInsert));
+	WriteBytes(buffer, &finalSelection, sizeof(finalSelection));
+	WriteText(buffer, textDeleted);
+	WriteText(buffer, textInserted);
+	WriteBytes(buffer, &isJoined, sizeof(isJoined));
+	WriteSelections(buffer, originalSelections);
+	WriteSelections(buffer, finalSelections);
+}
+
+const char* DocumentAction::Read(const char* data)
+{
+	std::memcpy(&originalSelection, data, sizeof(originalSelection));
+	data += sizeof(originalSelection);
+	std::memcpy(&selectionBeforeDelete, data, sizeof(selectionBeforeDelete));
+	data += sizeof(selectionBeforeDelete);
+	std::memcpy(&selectionBeforeInsert, data, sizeof(selectionBeforeInsert));
+	data += sizeof(selectionBeforeInsert);
+	std::memcpy(&selectionAfterInsert, data, sizeof(selectionAfterInsert));
+	data += sizeof(selectionAfterInsert);
+	std::memcpy(&finalSelection, data, sizeof(finalSelection));
+	data += sizeof(finalSelection);
+	data = ReadText(data, textDeleted);
+	data = ReadText(data, textInserted);
+	std::memcpy(&isJoined, data, sizeof(isJoined));
+	data += sizeof(isJoined);
+	data = ReadSelections(data, originalSelections);
+	return ReadSelections(data, finalSelections);
+}
+
+bool DocumentAction::IsSingleLineEdit() const
+{
+	//A plain insert or delete with a caret (no selection) that does not span lines
+	return
+		!isJoined &&
+		originalSelections.empty() &&
+		!originalSelection.IsVertical() &&
+		!finalSelection.IsVertical() &&
+		IsSamePosition(originalSelection.GetStart(), originalSelection.GetEnd()) &&
+		textDeleted.empty() != textInserted.empty() &&
+		textDeleted.find('\n') == std::string::npos &&
+		textInserted.find('\n') == std::string::npos;
+}
+
+bool DocumentAction::IsSamePosition(const DocumentPosition& lhs, const DocumentPosition& rhs)
+{
+	return !(lhs < rhs) && !(rhs < lhs);
+}
+
+void DocumentAction::WriteBytes(std::vector<char>& buffer, const void* data, unsigned long size)
+{
+	auto bytes = static_cast<const char*>(data);
+	buffer.insert(buffer.end(), bytes, bytes + size);
+}
+
+void DocumentAction::WriteText(std::vector<char>& buffer, const std::string& value)
+{
+	unsigned long size = value.size();
+	WriteBytes(buffer, &size, sizeof(size));
+	WriteBytes(buffer, value.data(), size);
+}
+
+void DocumentAction::WriteSelections(std::vector<char>& buffer, const std::vector<DocumentSelection>& value)
+{
+	unsigned long size = value.size();
+	WriteBytes(buffer, &size, sizeof(size));
+	WriteBytes(buffer, value.data(), size * sizeof(DocumentSelection));
+}
+
+const char* DocumentAction::ReadText(const char* data, std::string& value)
+{
+	unsigned long size = 0;
+	std::memcpy(&size, data, sizeof(size));
+	data += sizeof(size);
+	value.assign(data, size);
+	return data + size;
+}
+
+const char* DocumentAction::ReadSelections(const char* data, std::vector<DocumentSelection>& value)
+{
+	unsigned long size = 0;
+	std::memcpy(&size, data, sizeof(size));
+	data += sizeof(size);
+	value.resize(size);
+	if (size > 0)
+		std::memcpy(value.data(), data, size * sizeof(DocumentSelection));
+	return data + size * sizeof(DocumentSelection);
+}
@@ -13,6 +13,8 @@
 #pragma once
 #include "DocumentSelection.h"
 #include "DocumentOperations.h"
+#include <string>
+#include <vector>
 
 class DocumentAction
 {
@@ -33,6 +35,28 @@ public:
 	void SetTextInserted(const std::string& value);
 	void SetSelectionAfterInsert(const DocumentSelection& value);
 	void SetFinalSelection(const DocumentSelection& value);
+	const DocumentSelection& GetSelectionBeforeDelete() const;
+	const DocumentSelection& GetSelectionAfterInsert() const;
+
+	//An action joined to the one before it is part of the same edit of several selections
+	void SetJoined(bool value);
+	bool IsJoined() const;
+	void SetSelections(const std::vector<DocumentSelection>& original, const std::vector<DocumentSelection>& final);
+	const std::vector<DocumentSelection>& GetOriginalSelections() const;
+	const std::vector<DocumentSelection>& GetFinalSelections() const;
+
+	bool Coalesce(const DocumentAction& next);
+	void Write(std::vector<char>& buffer) const;
+	const char* Read(const char* data);
+
+private:
+	bool IsSingleLineEdit() const;
+	static bool IsSamePosition(const DocumentPosition& lhs, const DocumentPosition& rhs);
+	static void WriteBytes(std::vector<char>& buffer, const void* data, unsigned long size);
+	static void WriteText(std::vector<char>& buffer, const std::string& value);
+	static void WriteSelections(std::vector<char>& buffer, const std::vector<DocumentSelection>& value);
+	static const char* ReadText(const char* data, std::string& value);
+	static const char* ReadSelections(const char* data, std::vector<DocumentSelection>& value);
 
 private:
 	DocumentSelection originalSelection;
@@ -42,5 +66,8 @@ private:
 	std::string textInserted;
 	DocumentSelection selectionAfterInsert;
 	DocumentSelection finalSelection;
+	bool isJoined = false;
+	std::vector<DocumentSelection> originalSelections;
+	std::vector<DocumentSelection> finalSelections;
 };
 
@@ -11,11 +11,11 @@
 #include "pch.h"
 #include "DocumentColor.h"
 #include <cctype>
-#include <set>
 
 void DocumentColor::DrawLine(
 	HDC dc,
 	const std::string& text,
+	const std::vector<DocumentLexer::Run>& runs,
 	int top,
 	int bottom,
 	int left,
@@ -24,30 +24,36 @@ void DocumentColor::DrawLine(
 	unsigned long lastVisibleColumn,
 	unsigned long firstSelectedColumn,
 	unsigned long lastSelectedColumn,
+	const std::vector<DocumentSearch::Match>& matches,
 	bool isCurrentLine,
 	bool isEmptyVerticalSelection)
 {
-	State state = State::initial;
-	bool isIf = false;
-	bool isInclude = false;
-	bool isPragma = false;
+	//Consecutive characters with the same colors are drawn by a single text output call.
+	//Spaces join the segment they are in (only the background of a space is visible) and
+	//have their marker drawn over the segment afterwards.
+	unsigned long segmentIndex = 0;
+	unsigned long segmentColumn = 0;
+	unsigned long segmentLength = 0;
+	COLORREF segmentColor = DocumentColor::text;
+	COLORREF segmentBackColor = DocumentColor::background;
+	bool isSegmentColored = false;
+	std::vector<std::pair<unsigned long, COLORREF>> spaceMarkers;
 
 	unsigned long column = 0;
-	for (unsigned long index = 0; index < text.size(); ++index)
+	auto run = runs.begin();
+	auto match = matches.begin();
+	for (unsigned long index = 0; index < text.size() && column < lastVisibleColumn; ++index)
 	{
 		auto c = text[index];
+		while (match != matches.end() && match->lastColumn <= column)
+			++match;
 
-		//Transition the state
-		TransitionState(
-			text,
-			index,
-			state,
-			isIf,
-			isInclude,
-			isPragma);
+		//The runs were lexed ahead of time, only find the one covering this character
+		while (run != runs.end() && run->start + run->length <= index)
+			++run;
 
 		//Get the text colors
-		auto color = GetStateTextColor(state);
+		auto color = run == runs.end() ? DocumentColor::text : GetTokenTextColor(run->token);
 		auto backColor = isCurrentLine ?
 			DocumentColor::currentLineBackground :
 			DocumentColor::background;
@@ -58,24 +64,56 @@ void DocumentColor::DrawLine(
 			backColor = DocumentColor::selectionBackground;
 			color = DocumentColor::selectionText;
 		}
+		else if (match != matches.end() && column >= match->firstColumn)
+		{
+			//Highlight find matches behind the syntax colored text
+			backColor = DocumentColor::matchBackground;
+		}
 		else if (std::isspace(c))
 		{
 			//Shade the whitespace character a darker shade (only when not selected)
 			color = GetWhitespaceColor(color);
 		}
 
-		//Draw the given character (note that column is advanced in each call)
+		//Tabs are drawn as arrows so they end the current segment (note that column is advanced in the call)
 		if (c == '\t')
+		{
+			DrawSegment(dc, text.data() + segmentIndex, segmentLength, segmentColumn, segmentColor, segmentBackColor, spaceMarkers, top, bottom, left, charWidth, firstVisibleColumn);
+			segmentLength = 0;
 			DrawTab(dc, column, color, backColor, top, bottom, left, charWidth, firstVisibleColumn);
-		else if (c == ' ')
-			DrawSpace(dc, column, color, backColor, top, bottom, left, charWidth, firstVisibleColumn);
-		else
-			DrawCharacter(dc, c, column, color, backColor, top, bottom, left, charWidth, firstVisibleColumn);
+			continue;
+		}
+		if (column < firstVisibleColumn)
+		{
+			++column;
+			continue;
+		}
 
-		//Stop parsing/drawing if we reach the end of the visible area
-		if (column >= lastVisibleColumn)
-			break;
+		auto isSpace = c == ' ';
+		if (segmentLength > 0 &&
+			(backColor != segmentBackColor || (!isSpace && isSegmentColored && color != segmentColor)))
+		{
+			DrawSegment(dc, text.data() + segmentIndex, segmentLength, segmentColumn, segmentColor, segmentBackColor, spaceMarkers, top, bottom, left, charWidth, firstVisibleColumn);
+			segmentLength = 0;
+		}
+		if (segmentLength == 0)
+		{
+			segmentIndex = index;
+			segmentColumn = column;
+			segmentBackColor = backColor;
+			isSegmentColored = false;
+		}
+		if (isSpace)
+			spaceMarkers.push_back({ column, color });
+		else if (!isSegmentColored)
+		{
+			segmentColor = color;
+			isSegmentColored = true;
+		}
+		++segmentLength;
+		++column;
 	}
+	DrawSegment(dc, text.data() + segmentIndex, segmentLength, segmentColumn, segmentColor, segmentBackColor, spaceMarkers, top, bottom, left, charWidth, firstVisibleColumn);
 
 	if (isEmptyVerticalSelection && MATH::Between(firstVisibleColumn, lastVisibleColumn, firstSelectedColumn))
 	{
@@ -101,212 +139,23 @@ COLORREF DocumentColor::GetWhitespaceColor(COLORREF color)
 	return RGB(red, green, blue);
 }
 
-std::string DocumentColor::ScanWord(const std::string& line, unsigned long index)
-{
-	unsigned long end = index + 1;
-	while (end < line.size() && (line[end] == '_' || std::isalnum(line[end])))
-		++end;
-	return line.substr(index, end - index);
-}
-
-bool DocumentColor::IsInstructionKeyword(const std::string& word)
-{
-	static const std::set<std::string> keywords = {
-		"namespace", "using",
-		"class", "struct", "union", "enum",
-		"public", "protected", "private",
-		"virtual", "override", "final",
-		"typedef", "template", "typename",
-		"decltype",
-		"static", "friend", "inline", "extern",
-		"constexpr", "__declspec", "dllexport",
-		"if", "else", "for", "do", "while", "switch",
-		"case", "break", "continue", "default", "return", "goto",
-		"operator", "new", "delete", "typeid", "sizeof",
-		"__stdcall",
-		"const_cast", "static_cast", "dynamic_cast", "reinterpret_cast",
-		"this", "true", "false", "nullptr",
-		"try", "catch", "throw",
-		"static_assert",
-		"noexcept"
-	};
-	return keywords.find(word) != keywords.end();
-}
-
-bool DocumentColor::IsTypeKeyword(const std::string& word)
-{
-	static const std::set<std::string> keywords = {
-		"void", "bool", "short", "long", "int",
-		"signed", "unsigned",
-		"float", "double",
-		"const", "volatile",
-		"register", "auto",
-		"char", "wchar_t"
-	};
-	return keywords.find(word) != keywords.end();
-}
-
-void DocumentColor::TransitionState(
-	const std::string& text,
-	unsigned long index,
-	State& state,
-	bool& isIf,
-	bool& isInclude,
-	bool& isPragma)
-{
-	auto c = text[index];
-	auto hasNext = (index + 1) < text.size();
-	auto next = hasNext ? text[index + 1] : '\0';
-
-	//Determine the state of the current character based on the previous state
-	switch(state)
-	{
-	case State::initial:
-		if (c == '#')
-			state = State::preprocessor;
-		else if (!std::isspace(c))
-		{
-			state = State::none;
-			goto case_state_none;
-		}
-		break;
-
-	case State::none:
-	case_state_none:
-		if (c == '"')
-			state = State::string;
-		else if (c == '\'')
-			state = State::character;
-		else if (c == '/' && hasNext && next == '/')
-			state = State::singleLineComment;
-		else if (c == '_' || std::isalpha(c))
-		{
-			auto word = ScanWord(text, index);
-			if (IsInstructionKeyword(word))
-				state = State::instructionKeyword;
-			else if (IsTypeKeyword(word))
-				state = State::typeKeyword;
-			else if ((isIf && word == "defined") ||
-				(isPragma && word == "once"))
-				state = State::preprocessorKeyword;
-			else
-				state = State::identifier;
-		}
-		else if (isInclude && c == '<')
-			state = State::includeString;
-		else if (std::isdigit(c))
-			state = State::number;
-		else if (std::ispunct(c))
-			state = State::punctuation;
-		break;
-
-	case State::punctuation:
-	case State::stringEnd:
-	case State::characterEnd:
-		state = State::none;
-		goto case_state_none;
-
-	case State::number:
-		if (!std::isalnum(c) && c != '.')
-		{
-			state = State::none;
-			goto case_state_none;
-		}
-		break;
-
-	case State::includeString:
-		if (c == '>')
-			state = State::includeStringEnd;
-		break;
-
-	case State::includeStringEnd:
-		state = State::none;
-		goto case_state_none;
-
-	case State::string:
-		if (c == '\\')
-			state = State::stringEscape;
-		else if (c == '"')
-			state = State::stringEnd;
-		break;
-
-	case State::stringEscape:
-		state = State::string;
-		break;
-
-	case State::character:
-		if (c == '\\')
-			state = State::characterEscape;
-		else if (c == '\'')
-			state = State::characterEnd;
-		break;
-
-	case State::characterEscape:
-		state = State::character;
-		break;
-
-	case State::instructionKeyword:
-	case State::typeKeyword:
-	case State::identifier:
-		if (c != '_' && !std::isalnum(c))
-		{
-			state = State::none;
-			goto case_state_none;
-		}
-		break;
-
-	case State::preprocessor:
-		if (!std::isspace(c))
-		{
-			auto word = ScanWord(text, index);
-			if (word == "if")
-				isIf = true;
-			else if (word == "pragma")
-				isPragma = true;
-			else if (word == "include")
-				isInclude = true;
-			state = State::preprocessorKeyword;
-		}
-		break;
-
-	case State::preprocessorKeyword:
-		if (!std::isalpha(c))
-		{
-			state = State::none;
-			goto case_state_none;
-		}
-		break;
-
-	case State::singleLineComment:
-		break;
-	}
-}
-
-COLORREF DocumentColor::GetStateTextColor(State state)
+COLORREF DocumentColor::GetTokenTextColor(DocumentLexer::Token token)
 {
-	switch(state)
+	switch(token)
 	{
-	case State::string:
-	case State::stringEscape:
-	case State::stringEnd:
-	case State::includeString:
-	case State::includeStringEnd:
-	case State::character:
-	case State::characterEscape:
-	case State::characterEnd:
+	case DocumentLexer::Token::string:
 		return DocumentColor::string;
-	case State::punctuation:
+	case DocumentLexer::Token::punctuation:
 		return DocumentColor::punctuation;
-	case State::number:
+	case DocumentLexer::Token::number:
 		return DocumentColor::number;
-	case State::singleLineComment:
+	case DocumentLexer::Token::comment:
 		return DocumentColor::comment;
-	case State::instructionKeyword:
+	case DocumentLexer::Token::instructionKeyword:
 		return DocumentColor::instructionKeyword;
-	case State::typeKeyword:
+	case DocumentLexer::Token::typeKeyword:
 		return DocumentColor::typeKeyword;
-	case State::preprocessor:
-	case State::preprocessorKeyword:
+	case DocumentLexer::Token::preprocessor:
 		return DocumentColor::preprocessor;
 	default:
 		return DocumentColor::text;
@@ -359,66 +208,49 @@ void DocumentColor::DrawTab(
 	}
 }
 
-void DocumentColor::DrawSpace(
+void DocumentColor::DrawSegment(
 	HDC dc,
-	unsigned long& column,
+	const char* text,
+	unsigned long length,
+	unsigned long column,
 	COLORREF color,
 	COLORREF backColor,
+	std::vector<std::pair<unsigned long, COLORREF>>& spaceMarkers,
 	int top,
 	int bottom,
 	int left,
 	int charWidth,
 	unsigned long firstVisibleColumn)
 {
-	if (column >= firstVisibleColumn)
+	if (length == 0)
+		return;
+
+	//Every character advances a full column even if the font would place it differently
+	std::vector<int> widths(length, charWidth);
+	RECT rect = {0};
+	rect.top = top;
+	rect.bottom = bottom;
+	rect.left = left + (column - firstVisibleColumn) * charWidth;
+	rect.right = rect.left + length * charWidth;
+	::SetTextColor(dc, color);
+	::SetBkColor(dc, backColor);
+	::ExtTextOut(dc, rect.left, rect.top, ETO_OPAQUE|ETO_CLIPPED, &rect, text, length, widths.data());
+
+	//Neighboring spaces usually share a color so they share a brush as well
+	for (auto spaceMarker = spaceMarkers.begin(); spaceMarker != spaceMarkers.end(); )
 	{
-		if (backColor != DocumentColor::background)
+		auto markerColor = spaceMarker->second;
+		WIN::CBrush brush;
+		brush.Create(markerColor);
+		for (; spaceMarker != spaceMarkers.end() && spaceMarker->second == markerColor; ++spaceMarker)
 		{
-			RECT backRect = {0};
-			backRect.top = top;
-			backRect.bottom = bottom;
-			backRect.left = left + (column - firstVisibleColumn) * charWidth;
-			backRect.right = backRect.left + charWidth;
-			WIN::CBrush brush;
-			brush.Create(backColor);
-			::FillRect(dc, &backRect, brush);
+			RECT markerRect = {0};
+			markerRect.top = top + (bottom - top) / 2 - 1;
+			markerRect.bottom = markerRect.top + 2;
+			markerRect.left = left + ((spaceMarker->first - firstVisibleColumn) * charWidth) + charWidth / 2 - 1;
+			markerRect.right = markerRect.left + 2;
+			::FillRect(dc, &markerRect, brush);
 		}
-
-		RECT rect = {0};
-		rect.top = top + (bottom - top) / 2 - 1;
-		rect.bottom = rect.top + 2;
-		rect.left = left + ((column - firstVisibleColumn) * charWidth) + charWidth / 2 - 1;
-		rect.right = rect.left + 2;
-		WIN::CBrush brush;
-		brush.Create(color);
-		::FillRect(dc, &rect, brush);
-	}
-	++column;
-}
-
-void DocumentColor::DrawCharacter(
-	HDC dc,
-	char c,
-	unsigned long& column,
-	COLORREF color,
-	COLORREF backColor,
-	int top,
-	int bottom,
-	int left,
-	int charWidth,
-	unsigned long firstVisibleColumn)
-{
-	if (column >= firstVisibleColumn)
-	{
-		RECT rect = {0};
-		rect.top = top;
-		rect.bottom = bottom;
-		rect.left = left + (column - firstVisibleColumn) * charWidth;
-		rect.right = rect.left + charWidth;
-		::SetTextColor(dc, color);
-		::SetBkColor(dc, backColor);
-		::DrawText(dc, &c, 1, &rect, DT_LEFT|DT_SINGLELINE|DT_NOPREFIX);
 	}
-	++column;
+	spaceMarkers.clear();
 }
-
@@ -10,6 +10,11 @@
 // ---------- ----------------- ------------------------------------------------
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
+#include <string>
+#include <vector>
+#include <utility>
+#include "DocumentSearch.h"
+#include "DocumentLexer.h"
 
 class DocumentColor
 {
@@ -28,6 +33,8 @@ public:
 
 		currentLineBackground = RGB(64, 64, 64),
 
+		matchBackground = RGB(128, 96, 0),
+
 		comment = RGB(0, 255, 0),
 		string = RGB(192, 192, 192),
 		punctuation = RGB(255, 255, 255),
@@ -40,6 +47,7 @@ public:
 	static void DrawLine(
 		HDC dc,
 		const std::string& text,
+		const std::vector<DocumentLexer::Run>& runs,
 		int top,
 		int bottom,
 		int left,
@@ -48,44 +56,13 @@ public:
 		unsigned long lastVisibleColumn,
 		unsigned long firstSelectedColumn,
 		unsigned long lastSelectedColumn,
+		const std::vector<DocumentSearch::Match>& matches,
 		bool isCurrentLine,
 		bool isEmptyVerticalSelection);
 
 private:
-	enum class State
-	{
-		initial,
-		none,
-		string,
-		stringEscape,
-		stringEnd,
-		character,
-		characterEscape,
-		characterEnd,
-		singleLineComment,
-		instructionKeyword,
-		typeKeyword,
-		identifier,
-		preprocessor,
-		preprocessorKeyword,
-		includeString,
-		includeStringEnd,
-		number,
-		punctuation
-	};
-
 	static COLORREF GetWhitespaceColor(COLORREF color);
-	static std::string ScanWord(const std::string& line, unsigned long index);
-	static bool IsInstructionKeyword(const std::string& word);
-	static bool IsTypeKeyword(const std::string& word);
-	static void TransitionState(
-		const std::string& text,
-		unsigned long index,
-		State& state,
-		bool& isIf,
-		bool& isInclude,
-		bool& isPragma);
-	static COLORREF GetStateTextColor(State state);
+	static COLORREF GetTokenTextColor(DocumentLexer::Token token);
 	static void DrawTab(
 		HDC dc,
 		unsigned long& column,
@@ -96,22 +73,14 @@ private:
 		int left,
 		int charWidth,
 		unsigned long firstVisibleColumn);
-	static void DrawSpace(
+	static void DrawSegment(
 		HDC dc,
-		unsigned long& column,
-		COLORREF color,
-		COLORREF backColor,
-		int top,
-		int bottom,
-		int left,
-		int charWidth,
-		unsigned long firstVisibleColumn);
-	static void DrawCharacter(
-		HDC dc,
-		char c,
-		unsigned long& column,
+		const char* text,
+		unsigned long length,
+		unsigned long column,
 		COLORREF color,
 		COLORREF backColor,
+		std::vector<std::pair<unsigned long, COLORREF>>& spaceMarkers,
 		int top,
 		int bottom,
 		int left,
@@ -0,0 +1,90 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    DocumentDamage.Test.cpp
+// Description: This file defines all DocumentDamage unit tests.
+//
+// Created:     2026-10-17 16:34:12
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#include "DocumentDamage.h"
+#include <UnitTest/UnitTest.h>
+#include <random>
+#include <vector>
+using UnitTest::Assert;
+
+TEST_CLASS(DocumentDamageTest)
+{
+public:
+	DocumentDamageTest()
+	{
+	}
+
+	TEST_METHOD(InsertShiftsFollowingLines)
+	{
+		DocumentDamage damage;
+		Assert::IsTrue(damage.IsEmpty());
+		damage.Add(10, 1, 1);
+		damage.Add(11, 0, 2);
+		Assert::IsFalse(damage.IsEmpty());
+		Assert::AreEqual(10ul, damage.GetFirstLine());
+		Assert::AreEqual(13ul, damage.GetEndLine());
+		Assert::AreEqual(11ul, damage.GetOldEndLine());
+		Assert::AreEqual(11ul, damage.GetMovedFirstLine());
+		Assert::AreEqual(2l, damage.GetLineShift());
+	}
+
+	TEST_METHOD(DeleteMovesLinesAboveOldEnd)
+	{
+		//Deleting a selection over lines 10 to 14 leaves one line, line 15 moves up to line 11
+		DocumentDamage damage;
+		damage.Add(10, 5, 1);
+		Assert::AreEqual(10ul, damage.GetFirstLine());
+		Assert::AreEqual(11ul, damage.GetEndLine());
+		Assert::AreEqual(15ul, damage.GetOldEndLine());
+		Assert::AreEqual(11ul, damage.GetMovedFirstLine());
+		Assert::AreEqual(-4l, damage.GetLineShift());
+	}
+
+	TEST_METHOD(EraseInFrontOfDamage)
+	{
+		DocumentDamage damage;
+		damage.Add(20, 1, 1);
+		damage.Add(5, 3, 0);
+		Assert::AreEqual(5ul, damage.GetFirstLine());
+		Assert::AreEqual(18ul, damage.GetEndLine());
+		Assert::AreEqual(21ul, damage.GetOldEndLine());
+		Assert::AreEqual(-3l, damage.GetLineShift());
+	}
+
+	TEST_METHOD(RandomEditsKeepLinesOutsideRange)
+	{
+		//Lines are tracked by identity, changed and inserted lines get a new identity
+		std::mt19937 random(4321);
+		for (auto round = 0; round < 100; ++round)
+		{
+			std::vector<unsigned long> original;
+			for (auto index = 0ul; index < 50; ++index)
+				original.push_back(index);
+			auto lines = original;
+			auto nextId = 1000ul;
+			DocumentDamage damage;
+			for (auto edit = 0; edit < 5; ++edit)
+			{
+				auto line = random() % lines.size();
+				auto removed = random() % 3;
+				if (line + removed > lines.size() - 1)
+					removed = 0;
+				auto added = random() % 3;
+				lines.erase(lines.begin() + line, lines.begin() + line + removed);
+				for (auto index = 0ul; index < added; ++index)
+					lines.insert(lines.begin() + line, nextId++);
+				damage.Add(line, removed, added);
+			}
+
+			for (auto index = 0ul; index < damage.GetFirstLine(); ++index)
+				Assert::AreEqual(original[index], lines[index]);
+			Assert::AreEqual(static_cast<unsigned long>(original.size() - damage.GetOldEndLine()), static_cast<unsigned long>(lines.size() - damage.GetEndLine()));
+			for (auto index = damage.GetEndLine(); index < lines.size(); ++index)
+				Assert::AreEqual(original[index - damage.GetEndLine() + damage.GetOldEndLine()], lines[index]);
+		}
+	}
+};
@@ -0,0 +1,67 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    DocumentDamage.cpp
+// Description: This file implements all DocumentDamage member functions.
+//
+// Created:     2026-10-17 16:34:12
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#include "pch.h"
+#include "DocumentDamage.h"
+
+void DocumentDamage::Clear()
+{
+	empty = true;
+	firstLine = 0;
+	endLine = 0;
+	oldEndLine = 0;
+}
+
+void DocumentDamage::Add(unsigned long line, unsigned long removedCount, unsigned long addedCount)
+{
+	if (empty)
+	{
+		empty = false;
+		firstLine = line;
+		endLine = line;
+		oldEndLine = line;
+	}
+
+	//The line is in current line numbers, anything after the damaged range maps back to the
+	//original lines by the shift so far.  Unchanged lines between two edits are included.
+	auto end = MATH::Max(endLine, line + removedCount);
+	oldEndLine = end - endLine + oldEndLine;
+	endLine = end - removedCount + addedCount;
+	firstLine = MATH::Min(firstLine, line);
+}
+
+bool DocumentDamage::IsEmpty() const
+{
+	return empty;
+}
+
+unsigned long DocumentDamage::GetFirstLine() const
+{
+	return firstLine;
+}
+
+unsigned long DocumentDamage::GetEndLine() const
+{
+	return endLine;
+}
+
+unsigned long DocumentDamage::GetOldEndLine() const
+{
+	return oldEndLine;
+}
+
+unsigned long DocumentDamage::GetMovedFirstLine() const
+{
+	//Lines after the damage move from the old end to the new end, when lines were removed
+	//they land above the old end so the rows that change start at the new end.
+	return MATH::Min(endLine, oldEndLine);
+}
+
+long DocumentDamage::GetLineShift() const
+{
+	return static_cast<long>(endLine) - static_cast<long>(oldEndLine);
+}
@@ -0,0 +1,33 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    DocumentDamage.h
+// Description: This file declares the DocumentDamage class.  This class
+//              collects the lines changed by one or more edits as a single
+//              range.  Lines in front of the range are untouched and lines after
+//              it are unchanged but moved by the number of lines inserted minus
+//              the number removed, so a view can scroll them instead of
+//              repainting them.
+//
+// Created:     2026-10-17 16:34:12
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+class DocumentDamage
+{
+public:
+	void Clear();
+	void Add(unsigned long line, unsigned long removedCount, unsigned long addedCount);
+
+	bool IsEmpty() const;
+	unsigned long GetFirstLine() const;
+	unsigned long GetEndLine() const;
+	unsigned long GetOldEndLine() const;
+	unsigned long GetMovedFirstLine() const;
+	long GetLineShift() const;
+
+private:
+	bool empty = true;
+	unsigned long firstLine = 0;
+	unsigned long endLine = 0;
+	unsigned long oldEndLine = 0;
+};
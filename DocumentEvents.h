@@ -12,12 +12,15 @@
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "DocumentPosition.h"
+#include "DocumentDamage.h"
+#include "DocumentMetrics.h"
 
 class DocumentEvents
 {
 public:
-	virtual void OnDocumentSizeChanged() = 0;
+	virtual void OnDocumentSizeChanged(const DocumentMetrics& oldMetrics, const DocumentMetrics& newMetrics) = 0;
 	virtual void OnDocumentEditRegion(const DocumentPosition& start, const DocumentPosition& end) = 0;
+	virtual void OnDocumentLinesChanged(const DocumentDamage& damage) = 0;
 	virtual void OnDocumentSelectionChanged() = 0;
 };
 
@@ -0,0 +1,100 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    DocumentFileWriter.Test.cpp
+// Description: This file defines all DocumentFileWriter unit tests.
+//
+// Created:     2026-10-17 12:05:13
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#include "DocumentFileWriter.h"
+#include <UnitTest/UnitTest.h>
+#include <fstream>
+#include <sstream>
+#include <iterator>
+#include <chrono>
+#include <iostream>
+using UnitTest::Assert;
+
+TEST_CLASS(DocumentFileWriterTest)
+{
+public:
+	DocumentFileWriterTest()
+	{
+	}
+
+	TEST_METHOD(WriteLinesAndReplace)
+	{
+		//Tests run as parallel processes in the same directory, so each one uses its own files
+		{
+			std::ofstream out("WriteLinesAndReplace.txt");
+			out << "original" << std::endl;
+		}
+		DocumentFileWriter writer;
+		writer.Open("WriteLinesAndReplace.tmp");
+		writer.WriteLine("one  ");
+		writer.WriteLine("");
+		writer.WriteLine("three four", 5);
+		writer.Close();
+		DocumentFileWriter::Replace("WriteLinesAndReplace.tmp", "WriteLinesAndReplace.txt");
+
+		Assert::AreEqual(std::string("one  \r\n\r\nthree\r\n"), ReadFile("WriteLinesAndReplace.txt"));
+		Assert::IsFalse(std::ifstream("WriteLinesAndReplace.tmp").good());
+		::DeleteFile("WriteLinesAndReplace.txt");
+		::DeleteFile("WriteLinesAndReplace.tmp");
+	}
+
+	TEST_METHOD(UnclosedFileIsDeleted)
+	{
+		{
+			DocumentFileWriter writer;
+			writer.Open("UnclosedFileIsDeleted.tmp");
+			writer.WriteLine("partial");
+		}
+		auto exists = std::ifstream("UnclosedFileIsDeleted.tmp").good();
+		::DeleteFile("UnclosedFileIsDeleted.tmp");
+		Assert::IsFalse(exists);
+	}
+
+	TEST_METHOD(BufferedWriteMatchesLineFlush)
+	{
+		//Compare with the previous save loop which flushed the stream after every line
+		std::vector<std::string> lines;
+		for (auto index = 0; index < 100000; ++index)
+		{
+			std::ostringstream line;
+			line << "\tauto value" << index << " = CalculateValue(" << index << ");";
+			lines.push_back(line.str());
+		}
+
+		auto start = std::chrono::steady_clock::now();
+		{
+			std::ofstream out("BufferedWriteMatchesLineFlush.flush");
+			for (const auto& line: lines)
+				out << line << std::endl;
+		}
+		auto flushTime = std::chrono::steady_clock::now() - start;
+
+		start = std::chrono::steady_clock::now();
+		DocumentFileWriter writer;
+		writer.Open("BufferedWriteMatchesLineFlush.tmp");
+		for (const auto& line: lines)
+			writer.WriteLine(line);
+		writer.Close();
+		auto bufferedTime = std::chrono::steady_clock::now() - start;
+
+		Assert::AreEqual(ReadFile("BufferedWriteMatchesLineFlush.flush"), ReadFile("BufferedWriteMatchesLineFlush.tmp"));
+
+		//Tests run in parallel, so the timings are only reported (the runner reads the result from standard output)
+		std::cerr << "Buffered write " << std::chrono::duration_cast<std::chrono::microseconds>(bufferedTime).count()
+			<< " us, flush per line " << std::chrono::duration_cast<std::chrono::microseconds>(flushTime).count() << " us" << std::endl;
+		::DeleteFile("BufferedWriteMatchesLineFlush.flush");
+		::DeleteFile("BufferedWriteMatchesLineFlush.tmp");
+	}
+
+private:
+	static std::string ReadFile(const std::string& fileName)
+	{
+		std::ifstream in(fileName.c_str(), std::ios::binary);
+		return { std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>() };
+	}
+};
+
@@ -0,0 +1,84 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    DocumentFileWriter.cpp
+// Description: This file implements all DocumentFileWriter member functions.
+//
+// Created:     2026-10-17 12:05:13
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#include "pch.h"
+#include "DocumentFileWriter.h"
+
+const auto writeBufferSize = 1024ul * 1024ul;
+
+DocumentFileWriter::~DocumentFileWriter()
+{
+	//The file was never closed (an error occurred while writing), discard the partial file
+	if (file.Get() != nullptr)
+	{
+		file.Release();
+		::DeleteFile(fileName.c_str());
+	}
+}
+
+void DocumentFileWriter::Open(const std::string& fileName)
+{
+	constexpr auto trace = __PRETTY_FUNCTION__;
+	auto fileHandle = ::CreateFile(
+		fileName.c_str(),
+		GENERIC_WRITE,
+		0,
+		nullptr,
+		CREATE_ALWAYS,
+		FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+		nullptr);
+	ERR::CheckWindowsError(fileHandle == INVALID_HANDLE_VALUE, trace, "CreateFile");
+	file.Attach(fileHandle);
+	this->fileName = fileName;
+	buffer.clear();
+	buffer.reserve(writeBufferSize);
+}
+
+void DocumentFileWriter::WriteLine(const std::string& line)
+{
+	WriteLine(line.data(), line.size());
+}
+
+void DocumentFileWriter::WriteLine(const char* text, unsigned long length)
+{
+	buffer.append(text, length);
+	buffer.append("\r\n");
+	if (buffer.size() >= writeBufferSize)
+		WriteBuffer();
+}
+
+void DocumentFileWriter::Close()
+{
+	constexpr auto trace = __PRETTY_FUNCTION__;
+	WriteBuffer();
+
+	//Make sure the contents are on disk before the file is renamed over the original
+	ERR::CheckWindowsError(!::FlushFileBuffers(file.Get()), trace, "FlushFileBuffers");
+	file.Release();
+}
+
+void DocumentFileWriter::Replace(const std::string& source, const std::string& target)
+{
+	constexpr auto trace = __PRETTY_FUNCTION__;
+	auto result = ::MoveFileEx(
+		source.c_str(),
+		target.c_str(),
+		MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+	ERR::CheckWindowsError(!result, trace, "MoveFileEx");
+}
+
+void DocumentFileWriter::WriteBuffer()
+{
+	constexpr auto trace = __PRETTY_FUNCTION__;
+	if (buffer.empty())
+		return;
+	DWORD written = 0;
+	auto result = ::WriteFile(file.Get(), buffer.data(), buffer.size(), &written, nullptr);
+	ERR::CheckWindowsError(!result || written != buffer.size(), trace, "WriteFile");
+	buffer.clear();
+}
+
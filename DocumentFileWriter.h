@@ -0,0 +1,39 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    DocumentFileWriter.h
+// Description: This file declares the DocumentFileWriter class.  This class
+//              writes the lines of a document through a large buffer (instead
+//              of flushing a stream per line) and is used to save a document to
+//              a temporary file that then atomically replaces the original.
+//
+// Created:     2026-10-17 12:05:13
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <string>
+#include <CRL/WinUtility.h>
+
+class DocumentFileWriter
+{
+public:
+	DocumentFileWriter() = default;
+	DocumentFileWriter(const DocumentFileWriter& rhs) = delete;
+	~DocumentFileWriter();
+
+	DocumentFileWriter& operator=(const DocumentFileWriter& rhs) = delete;
+
+	void Open(const std::string& fileName);
+	void WriteLine(const std::string& line);
+	void WriteLine(const char* text, unsigned long length);
+	void Close();
+
+	static void Replace(const std::string& source, const std::string& target);
+
+private:
+	void WriteBuffer();
+
+private:
+	std::string fileName;
+	WIN::CHandle file;
+	std::string buffer;
+};
+
@@ -0,0 +1,77 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    DocumentFind.Test.cpp
+// Description: This file defines all DocumentFind unit tests.
+//
+// Created:     2026-10-17 14:40:17
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#include "DocumentFind.h"
+#include <UnitTest/UnitTest.h>
+using UnitTest::Assert;
+
+TEST_CLASS(DocumentFindTest)
+{
+public:
+	DocumentFindTest()
+	{
+	}
+
+	TEST_METHOD(FullSearchVisitsEveryLine)
+	{
+		DocumentFind find;
+		find.Start(DocumentSearch("a", false, false, false), 1);
+		Assert::IsTrue(find.IsRunning());
+		AssertLines({ 0, 1, 2 }, VisitLines(find, 3, 3));
+		Assert::IsTrue(find.IsDone(3));
+		Assert::IsFalse(find.IsDone(4));
+	}
+
+	TEST_METHOD(ExtendedQueryOnlySearchesPreviousMatches)
+	{
+		DocumentFind find;
+		find.Start(DocumentSearch("get", false, false, false), 1);
+		unsigned long line = 0;
+		for (auto count = 0; count < 5; ++count)
+			if (find.NextLine(10, line) && line % 2 == 0)
+				find.AddMatches(line, 1);
+		Assert::AreEqual(3ul, find.GetMatchCount());
+
+		//Lines 0, 2 and 4 matched and lines 5 through 9 were never searched
+		find.Start(DocumentSearch("getl", false, false, false), 1);
+		Assert::AreEqual(0ul, find.GetMatchCount());
+		AssertLines({ 0, 2, 4, 5, 6, 7, 8, 9 }, VisitLines(find, 10, 20));
+	}
+
+	TEST_METHOD(ChangedQueryStartsOver)
+	{
+		DocumentFind find;
+		find.Start(DocumentSearch("get", false, false, false), 1);
+		VisitLines(find, 4, 4);
+		find.AddMatches(1, 1);
+
+		find.Start(DocumentSearch("set", false, false, false), 1);
+		Assert::AreEqual(4ul, static_cast<unsigned long>(VisitLines(find, 4, 4).size()));
+		find.Start(DocumentSearch("sett", false, true, false), 1);
+		Assert::AreEqual(4ul, static_cast<unsigned long>(VisitLines(find, 4, 4).size()));
+		find.Start(DocumentSearch("settle", false, true, false), 2);
+		Assert::AreEqual(4ul, static_cast<unsigned long>(VisitLines(find, 4, 4).size()));
+	}
+
+private:
+	static void AssertLines(const std::vector<unsigned long>& expected, const std::vector<unsigned long>& actual)
+	{
+		Assert::AreEqual(static_cast<unsigned long>(expected.size()), static_cast<unsigned long>(actual.size()));
+		for (auto index = 0ul; index < expected.size(); ++index)
+			Assert::AreEqual(expected[index], actual[index]);
+	}
+
+	static std::vector<unsigned long> VisitLines(DocumentFind& find, unsigned long lineCount, unsigned long maxLines)
+	{
+		std::vector<unsigned long> lines;
+		unsigned long line = 0;
+		while (lines.size() < maxLines && find.NextLine(lineCount, line))
+			lines.push_back(line);
+		return lines;
+	}
+};
+
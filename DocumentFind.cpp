@@ -0,0 +1,100 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    DocumentFind.cpp
+// Description: This file implements all DocumentFind member functions.
+//
+// Created:     2026-10-17 14:40:17
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#include "pch.h"
+#include "DocumentFind.h"
+
+void DocumentFind::Start(const DocumentSearch& search, unsigned long version)
+{
+	if (CanNarrow(search, version))
+	{
+		//Lines that matched the shorter query and the lines it had not reached yet (both in order)
+		std::vector<unsigned long> lines(std::move(matchedLines));
+		lines.insert(lines.end(), candidates.begin() + nextCandidate, candidates.end());
+		candidates = std::move(lines);
+	}
+	else
+	{
+		candidates.clear();
+		nextLine = 0;
+	}
+	nextCandidate = 0;
+	matchedLines.clear();
+	matchCount = 0;
+	this->search = search;
+	this->version = version;
+	running = !search.IsEmpty() && search.IsValid();
+}
+
+void DocumentFind::Stop()
+{
+	running = false;
+}
+
+bool DocumentFind::IsRunning() const
+{
+	return running;
+}
+
+bool DocumentFind::IsDone(unsigned long lineCount) const
+{
+	return nextCandidate == candidates.size() && nextLine >= lineCount;
+}
+
+const DocumentSearch& DocumentFind::GetSearch() const
+{
+	return search;
+}
+
+unsigned long DocumentFind::GetVersion() const
+{
+	return version;
+}
+
+unsigned long DocumentFind::GetMatchCount() const
+{
+	return matchCount;
+}
+
+bool DocumentFind::NextLine(unsigned long lineCount, unsigned long& line)
+{
+	if (nextCandidate < candidates.size())
+	{
+		line = candidates[nextCandidate++];
+		return true;
+	}
+	if (nextLine < lineCount)
+	{
+		line = nextLine++;
+		return true;
+	}
+	return false;
+}
+
+void DocumentFind::AddMatches(unsigned long line, unsigned long count)
+{
+	matchedLines.push_back(line);
+	matchCount += count;
+}
+
+bool DocumentFind::CanNarrow(const DocumentSearch& search, unsigned long version) const
+{
+	//Any line containing the longer text also contains the shorter text it starts with.
+	//That does not hold for regular expressions or whole words, and edits move the lines.
+	const auto& previous = this->search;
+	return
+		version == this->version &&
+		!previous.IsEmpty() &&
+		previous.IsValid() &&
+		!previous.IsRegex() &&
+		!previous.IsWholeWord() &&
+		!search.IsRegex() &&
+		!search.IsWholeWord() &&
+		search.IsMatchCase() == previous.IsMatchCase() &&
+		search.GetPattern().compare(0, previous.GetPattern().size(), previous.GetPattern()) == 0;
+}
+
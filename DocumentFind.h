@@ -0,0 +1,44 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    DocumentFind.h
+// Description: This file declares the DocumentFind class.  This class tracks the
+//              progress of an incremental find (the lines still to be searched
+//              and the lines that matched).  A query that extends the previous
+//              one (more text typed with the same options) only needs to search
+//              the lines that matched before and the lines not yet searched.
+//
+// Created:     2026-10-17 14:40:17
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <vector>
+#include "DocumentSearch.h"
+
+class DocumentFind
+{
+public:
+	void Start(const DocumentSearch& search, unsigned long version);
+	void Stop();
+	bool IsRunning() const;
+	bool IsDone(unsigned long lineCount) const;
+	const DocumentSearch& GetSearch() const;
+	unsigned long GetVersion() const;
+	unsigned long GetMatchCount() const;
+
+	bool NextLine(unsigned long lineCount, unsigned long& line);
+	void AddMatches(unsigned long line, unsigned long count);
+
+private:
+	bool CanNarrow(const DocumentSearch& search, unsigned long version) const;
+
+private:
+	friend class DocumentFindTest;
+	DocumentSearch search;
+	unsigned long version = 0;
+	bool running = false;
+	std::vector<unsigned long> candidates;
+	unsigned long nextCandidate = 0;
+	unsigned long nextLine = 0;
+	std::vector<unsigned long> matchedLines;
+	unsigned long matchCount = 0;
+};
+
@@ -0,0 +1,31 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    DocumentIndexThread.cpp
+// Description: This file implements all DocumentIndexThread member functions.
+//
+// Created:     2026-10-17 10:41:19
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#include "DocumentIndexThread.h"
+
+//Each chunk is published as soon as it is indexed, so keep them small enough to stream
+const auto indexChunkSize = 1024ul * 1024ul;
+
+DocumentIndexThread::DocumentIndexThread(DocumentMappedFile* file)
+	: file(file), stopping(false)
+{
+	Start();
+}
+
+DocumentIndexThread::~DocumentIndexThread()
+{
+	//The document is going away (or being reopened), stop at the next chunk boundary
+	stopping = true;
+	Stop();
+}
+
+void DocumentIndexThread::Run()
+{
+	while (!stopping && !file->IndexChunk(indexChunkSize))
+		;
+}
+
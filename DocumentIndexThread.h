@@ -0,0 +1,33 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    DocumentIndexThread.h
+// Description: This file declares the DocumentIndexThread class.  This thread
+//              indexes the remainder of a memory mapped document in the
+//              background so the document can be displayed while it loads.
+//
+// Created:     2026-10-17 10:41:19
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "BaseThread.h"
+#include "DocumentMappedFile.h"
+#include <atomic>
+#include <memory>
+
+class DocumentIndexThread : public BaseThread
+{
+public:
+	DocumentIndexThread(DocumentMappedFile* file);
+	DocumentIndexThread(const DocumentIndexThread& rhs) = delete;
+	~DocumentIndexThread();
+
+	DocumentIndexThread& operator=(const DocumentIndexThread& rhs) = delete;
+
+	void Run() final;
+
+private:
+	DocumentMappedFile* file = nullptr;
+	std::atomic<bool> stopping;
+};
+
+typedef std::unique_ptr<DocumentIndexThread> DocumentIndexThreadPtr;
+
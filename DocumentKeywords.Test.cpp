@@ -0,0 +1,158 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    DocumentKeywords.Test.cpp
+// Description: This file defines all DocumentKeywords unit tests.
+//
+// Created:     2026-10-17 15:21:09
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#include "DocumentKeywords.h"
+#include <UnitTest/UnitTest.h>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <cctype>
+using UnitTest::Assert;
+
+TEST_CLASS(DocumentKeywordsTest)
+{
+public:
+	DocumentKeywordsTest()
+	{
+	}
+
+	TEST_METHOD(ClassifiesEveryKeyword)
+	{
+		for (const auto& word: GetInstructionKeywords())
+			Assert::IsTrue(Classify(word) == DocumentLexer::Token::instructionKeyword);
+		for (const auto& word: GetTypeKeywords())
+			Assert::IsTrue(Classify(word) == DocumentLexer::Token::typeKeyword);
+		Assert::AreEqual(static_cast<unsigned long>(GetInstructionKeywords().size() + GetTypeKeywords().size()), DocumentKeywords::keywordCount);
+	}
+
+	TEST_METHOD(OtherWordsAreText)
+	{
+		Assert::IsTrue(Classify("") == DocumentLexer::Token::text);
+		Assert::IsTrue(Classify("in") == DocumentLexer::Token::text);
+		Assert::IsTrue(Classify("integer") == DocumentLexer::Token::text);
+		Assert::IsTrue(Classify("Class") == DocumentLexer::Token::text);
+		Assert::IsTrue(Classify("static_cas") == DocumentLexer::Token::text);
+		Assert::IsTrue(Classify("DocumentKeywords") == DocumentLexer::Token::text);
+		Assert::IsTrue(DocumentKeywords::Classify("intx", 3) == DocumentLexer::Token::typeKeyword);
+	}
+
+	TEST_METHOD(ClassifyMatchesStdSet)
+	{
+		//Compare with the previous substr and std::set lookups over the words of the project sources
+		auto corpus = LoadCorpus();
+		std::vector<std::pair<unsigned long, unsigned long>> words;
+		for (unsigned long index = 0; index < corpus.size(); )
+		{
+			if (corpus[index] != '_' && !std::isalpha(corpus[index]))
+			{
+				++index;
+				continue;
+			}
+			auto end = index + 1;
+			while (end < corpus.size() && (corpus[end] == '_' || std::isalnum(corpus[end])))
+				++end;
+			words.push_back({ index, end - index });
+			index = end;
+		}
+
+		auto start = std::chrono::steady_clock::now();
+		unsigned long expected = 0;
+		for (const auto& word: words)
+			expected += static_cast<unsigned long>(StdSetClassify(corpus.substr(word.first, word.second)));
+		auto stdTime = std::chrono::steady_clock::now() - start;
+
+		start = std::chrono::steady_clock::now();
+		unsigned long actual = 0;
+		for (const auto& word: words)
+			actual += static_cast<unsigned long>(DocumentKeywords::Classify(corpus.data() + word.first, word.second));
+		auto hashTime = std::chrono::steady_clock::now() - start;
+
+		Assert::AreEqual(expected, actual);
+
+		//Tests run in parallel, so the timings are only reported (the runner reads the result from standard output)
+		std::cerr << "Keyword table " << std::chrono::duration_cast<std::chrono::microseconds>(hashTime).count()
+			<< " us, std::set " << std::chrono::duration_cast<std::chrono::microseconds>(stdTime).count() << " us" << std::endl;
+	}
+
+private:
+	static DocumentLexer::Token Classify(const std::string& word)
+	{
+		return DocumentKeywords::Classify(word.c_str(), word.size());
+	}
+
+	static std::string LoadCorpus()
+	{
+		//Falls back to a generated source when the tests do not run from the project folder
+		const std::vector<std::string> fileNames = {
+			"Document.cpp", "DocumentView.cpp", "DocumentLexer.cpp", "DocumentKeywords.cpp",
+			"MainFrame.cpp", "ProjectWindow.cpp", "Project.cpp", "BuildThread.cpp"
+		};
+		std::string sources;
+		for (const auto& fileName: fileNames)
+		{
+			std::ifstream in(fileName.c_str());
+			sources.append(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+		}
+		if (sources.empty())
+			sources = "\tfor (unsigned long index = 0; index < lines.size(); ++index)\n"
+				"\t\tif (!IsTabFree(lines[index])) return static_cast<int>(GetColumnWidth(index));\n";
+
+		std::string corpus;
+		while (corpus.size() < 8 * 1024 * 1024)
+			corpus += sources;
+		return corpus;
+	}
+
+	static DocumentLexer::Token StdSetClassify(const std::string& word)
+	{
+		static const std::set<std::string> instructionKeywords(GetInstructionKeywords().begin(), GetInstructionKeywords().end());
+		static const std::set<std::string> typeKeywords(GetTypeKeywords().begin(), GetTypeKeywords().end());
+		if (instructionKeywords.find(word) != instructionKeywords.end())
+			return DocumentLexer::Token::instructionKeyword;
+		if (typeKeywords.find(word) != typeKeywords.end())
+			return DocumentLexer::Token::typeKeyword;
+		return DocumentLexer::Token::text;
+	}
+
+	static const std::vector<std::string>& GetInstructionKeywords()
+	{
+		static const std::vector<std::string> keywords = {
+			"namespace", "using",
+			"class", "struct", "union", "enum",
+			"public", "protected", "private",
+			"virtual", "override", "final",
+			"typedef", "template", "typename",
+			"decltype",
+			"static", "friend", "inline", "extern",
+			"constexpr", "__declspec", "dllexport",
+			"if", "else", "for", "do", "while", "switch",
+			"case", "break", "continue", "default", "return", "goto",
+			"operator", "new", "delete", "typeid", "sizeof",
+			"__stdcall",
+			"const_cast", "static_cast", "dynamic_cast", "reinterpret_cast",
+			"this", "true", "false", "nullptr",
+			"try", "catch", "throw",
+			"static_assert",
+			"noexcept"
+		};
+		return keywords;
+	}
+
+	static const std::vector<std::string>& GetTypeKeywords()
+	{
+		static const std::vector<std::string> keywords = {
+			"void", "bool", "short", "long", "int",
+			"signed", "unsigned",
+			"float", "double",
+			"const", "volatile",
+			"register", "auto",
+			"char", "wchar_t"
+		};
+		return keywords;
+	}
+};
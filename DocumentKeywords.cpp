@@ -0,0 +1,159 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    DocumentKeywords.cpp
+// Description: This file implements all DocumentKeywords member functions.
+//
+// Created:     2026-10-17 15:21:09
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#include "pch.h"
+#include "DocumentKeywords.h"
+#include <cstring>
+
+constexpr unsigned long DocumentKeywords::tableSize = 256;
+
+constexpr DocumentKeywords::Keyword DocumentKeywords::Define(const char* word, DocumentLexer::Token token)
+{
+	return Keyword{ word, GetLength(word), token };
+}
+
+constexpr unsigned long DocumentKeywords::GetLength(const char* word)
+{
+	return *word == '\0' ? 0 : 1 + GetLength(word + 1);
+}
+
+constexpr unsigned long DocumentKeywords::Hash(const char* word, unsigned long length)
+{
+	//The multipliers were chosen so that no two keywords share a slot (see IsPerfectHash)
+	return (length * 6 +
+		static_cast<unsigned char>(word[0]) * 8 +
+		static_cast<unsigned char>(word[length - 1]) * 20 +
+		static_cast<unsigned char>(word[length / 2])) % tableSize;
+}
+
+constexpr DocumentKeywords::Keyword DocumentKeywords::keywords[] = {
+	Define("namespace", DocumentLexer::Token::instructionKeyword),
+	Define("using", DocumentLexer::Token::instructionKeyword),
+	Define("class", DocumentLexer::Token::instructionKeyword),
+	Define("struct", DocumentLexer::Token::instructionKeyword),
+	Define("union", DocumentLexer::Token::instructionKeyword),
+	Define("enum", DocumentLexer::Token::instructionKeyword),
+	Define("public", DocumentLexer::Token::instructionKeyword),
+	Define("protected", DocumentLexer::Token::instructionKeyword),
+	Define("private", DocumentLexer::Token::instructionKeyword),
+	Define("virtual", DocumentLexer::Token::instructionKeyword),
+	Define("override", DocumentLexer::Token::instructionKeyword),
+	Define("final", DocumentLexer::Token::instructionKeyword),
+	Define("typedef", DocumentLexer::Token::instructionKeyword),
+	Define("template", DocumentLexer::Token::instructionKeyword),
+	Define("typename", DocumentLexer::Token::instructionKeyword),
+	Define("decltype", DocumentLexer::Token::instructionKeyword),
+	Define("static", DocumentLexer::Token::instructionKeyword),
+	Define("friend", DocumentLexer::Token::instructionKeyword),
+	Define("inline", DocumentLexer::Token::instructionKeyword),
+	Define("extern", DocumentLexer::Token::instructionKeyword),
+	Define("constexpr", DocumentLexer::Token::instructionKeyword),
+	Define("__declspec", DocumentLexer::Token::instructionKeyword),
+	Define("dllexport", DocumentLexer::Token::instructionKeyword),
+	Define("if", DocumentLexer::Token::instructionKeyword),
+	Define("else", DocumentLexer::Token::instructionKeyword),
+	Define("for", DocumentLexer::Token::instructionKeyword),
+	Define("do", DocumentLexer::Token::instructionKeyword),
+	Define("while", DocumentLexer::Token::instructionKeyword),
+	Define("switch", DocumentLexer::Token::instructionKeyword),
+	Define("case", DocumentLexer::Token::instructionKeyword),
+	Define("break", DocumentLexer::Token::instructionKeyword),
+	Define("continue", DocumentLexer::Token::instructionKeyword),
+	Define("default", DocumentLexer::Token::instructionKeyword),
+	Define("return", DocumentLexer::Token::instructionKeyword),
+	Define("goto", DocumentLexer::Token::instructionKeyword),
+	Define("operator", DocumentLexer::Token::instructionKeyword),
+	Define("new", DocumentLexer::Token::instructionKeyword),
+	Define("delete", DocumentLexer::Token::instructionKeyword),
+	Define("typeid", DocumentLexer::Token::instructionKeyword),
+	Define("sizeof", DocumentLexer::Token::instructionKeyword),
+	Define("__stdcall", DocumentLexer::Token::instructionKeyword),
+	Define("const_cast", DocumentLexer::Token::instructionKeyword),
+	Define("static_cast", DocumentLexer::Token::instructionKeyword),
+	Define("dynamic_cast", DocumentLexer::Token::instructionKeyword),
+	Define("reinterpret_cast", DocumentLexer::Token::instructionKeyword),
+	Define("this", DocumentLexer::Token::instructionKeyword),
+	Define("true", DocumentLexer::Token::instructionKeyword),
+	Define("false", DocumentLexer::Token::instructionKeyword),
+	Define("nullptr", DocumentLexer::Token::instructionKeyword),
+	Define("try", DocumentLexer::Token::instructionKeyword),
+	Define("catch", DocumentLexer::Token::instructionKeyword),
+	Define("throw", DocumentLexer::Token::instructionKeyword),
+	Define("static_assert", DocumentLexer::Token::instructionKeyword),
+	Define("noexcept", DocumentLexer::Token::instructionKeyword),
+
+	Define("void", DocumentLexer::Token::typeKeyword),
+	Define("bool", DocumentLexer::Token::typeKeyword),
+	Define("short", DocumentLexer::Token::typeKeyword),
+	Define("long", DocumentLexer::Token::typeKeyword),
+	Define("int", DocumentLexer::Token::typeKeyword),
+	Define("signed", DocumentLexer::Token::typeKeyword),
+	Define("unsigned", DocumentLexer::Token::typeKeyword),
+	Define("float", DocumentLexer::Token::typeKeyword),
+	Define("double", DocumentLexer::Token::typeKeyword),
+	Define("const", DocumentLexer::Token::typeKeyword),
+	Define("volatile", DocumentLexer::Token::typeKeyword),
+	Define("register", DocumentLexer::Token::typeKeyword),
+	Define("auto", DocumentLexer::Token::typeKeyword),
+	Define("char", DocumentLexer::Token::typeKeyword),
+	Define("wchar_t", DocumentLexer::Token::typeKeyword)
+};
+
+constexpr unsigned long DocumentKeywords::keywordCount = sizeof(keywords) / sizeof(keywords[0]);
+
+constexpr DocumentKeywords::Keyword DocumentKeywords::FindKeyword(unsigned long slot, unsigned long index)
+{
+	//Empty slots hold a zero length keyword that no scanned word can match
+	return index == keywordCount ? Define("", DocumentLexer::Token::text) :
+		Hash(keywords[index].word, keywords[index].length) == slot ? keywords[index] :
+		FindKeyword(slot, index + 1);
+}
+
+constexpr unsigned long DocumentKeywords::CountKeywords(unsigned long slot, unsigned long index)
+{
+	return index == keywordCount ? 0 :
+		(Hash(keywords[index].word, keywords[index].length) == slot ? 1 : 0) + CountKeywords(slot, index + 1);
+}
+
+constexpr bool DocumentKeywords::IsPerfectHash(unsigned long index)
+{
+	return index == keywordCount ||
+		(CountKeywords(Hash(keywords[index].word, keywords[index].length), 0) == 1 && IsPerfectHash(index + 1));
+}
+
+template <unsigned long... Slots>
+struct DocumentKeywords::Table
+{
+	static constexpr Keyword entries[sizeof...(Slots)] = { FindKeyword(Slots, 0)... };
+};
+
+template <unsigned long... Slots>
+constexpr DocumentKeywords::Keyword DocumentKeywords::Table<Slots...>::entries[sizeof...(Slots)];
+
+template <unsigned long Count, unsigned long... Slots>
+struct DocumentKeywords::MakeTable : MakeTable<Count - 1, Count - 1, Slots...>
+{
+};
+
+template <unsigned long... Slots>
+struct DocumentKeywords::MakeTable<0, Slots...>
+{
+	typedef Table<Slots...> Type;
+};
+
+DocumentLexer::Token DocumentKeywords::Classify(const char* word, unsigned long length)
+{
+	static_assert(IsPerfectHash(0), "Two keywords share a hash slot, choose different hash multipliers");
+	typedef MakeTable<tableSize>::Type KeywordTable;
+
+	if (length == 0)
+		return DocumentLexer::Token::text;
+	const auto& keyword = KeywordTable::entries[Hash(word, length)];
+	return keyword.length == length && std::memcmp(keyword.word, word, length) == 0 ?
+		keyword.token :
+		DocumentLexer::Token::text;
+}
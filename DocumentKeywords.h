@@ -0,0 +1,44 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    DocumentKeywords.h
+// Description: This file declares the DocumentKeywords class.  Keywords are
+//              classified with a perfect hash whose table is generated at
+//              compile time, so a lookup is one hash and one comparison and
+//              never allocates.
+//
+// Created:     2026-10-17 15:21:09
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "DocumentLexer.h"
+
+class DocumentKeywords
+{
+public:
+	static DocumentLexer::Token Classify(const char* word, unsigned long length);
+
+private:
+	friend class DocumentKeywordsTest;
+
+	struct Keyword
+	{
+		const char* word;
+		unsigned long length;
+		DocumentLexer::Token token;
+	};
+
+	template <unsigned long... Slots>
+	struct Table;
+	template <unsigned long Count, unsigned long... Slots>
+	struct MakeTable;
+
+	static constexpr Keyword Define(const char* word, DocumentLexer::Token token);
+	static constexpr unsigned long GetLength(const char* word);
+	static constexpr unsigned long Hash(const char* word, unsigned long length);
+	static constexpr Keyword FindKeyword(unsigned long slot, unsigned long index);
+	static constexpr unsigned long CountKeywords(unsigned long slot, unsigned long index);
+	static constexpr bool IsPerfectHash(unsigned long index);
+
+	static const unsigned long tableSize;
+	static const Keyword keywords[];
+	static const unsigned long keywordCount;
+};
@@ -0,0 +1,141 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    DocumentLexer.Test.cpp
+// Description: This file defines all DocumentLexer unit tests.
+//
+// Created:     2026-10-17 14:02:37
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#include "DocumentLexer.h"
+#include <UnitTest/UnitTest.h>
+#include <chrono>
+#include <iostream>
+using UnitTest::Assert;
+
+TEST_CLASS(DocumentLexerTest)
+{
+public:
+	DocumentLexerTest()
+	{
+	}
+
+	TEST_METHOD(RunsMergeCharactersOfTheSameToken)
+	{
+		std::vector<DocumentLexer::Run> runs;
+		auto state = DocumentLexer::LexLine("int x = 42; // done", DocumentLexer::LineState(), runs);
+		Assert::IsTrue(state.context == DocumentLexer::Context::code);
+		Assert::AreEqual(8ul, static_cast<unsigned long>(runs.size()));
+		AssertRun(runs[0], 0, 3, DocumentLexer::Token::typeKeyword);
+		AssertRun(runs[1], 3, 3, DocumentLexer::Token::text);
+		AssertRun(runs[2], 6, 1, DocumentLexer::Token::punctuation);
+		AssertRun(runs[3], 7, 1, DocumentLexer::Token::text);
+		AssertRun(runs[4], 8, 2, DocumentLexer::Token::number);
+		AssertRun(runs[5], 10, 1, DocumentLexer::Token::punctuation);
+		AssertRun(runs[6], 11, 1, DocumentLexer::Token::text);
+		AssertRun(runs[7], 12, 7, DocumentLexer::Token::comment);
+	}
+
+	TEST_METHOD(PreprocessorIncludeIsString)
+	{
+		std::vector<DocumentLexer::Run> runs;
+		DocumentLexer::LexLine("#include <set>", DocumentLexer::LineState(), runs);
+		Assert::AreEqual(3ul, static_cast<unsigned long>(runs.size()));
+		AssertRun(runs[0], 0, 8, DocumentLexer::Token::preprocessor);
+		AssertRun(runs[1], 8, 1, DocumentLexer::Token::text);
+		AssertRun(runs[2], 9, 5, DocumentLexer::Token::string);
+	}
+
+	TEST_METHOD(BlockCommentSpansLines)
+	{
+		std::vector<DocumentLexer::Run> runs;
+		auto state = DocumentLexer::LexLine("a /*/ b", DocumentLexer::LineState(), runs);
+		Assert::IsTrue(state.context == DocumentLexer::Context::blockComment);
+		AssertRun(runs.back(), 2, 5, DocumentLexer::Token::comment);
+
+		state = DocumentLexer::LexLine("still */ if", state, runs);
+		Assert::IsTrue(state.context == DocumentLexer::Context::code);
+		Assert::AreEqual(3ul, static_cast<unsigned long>(runs.size()));
+		AssertRun(runs[0], 0, 8, DocumentLexer::Token::comment);
+		AssertRun(runs[2], 9, 2, DocumentLexer::Token::instructionKeyword);
+	}
+
+	TEST_METHOD(EmptyLineKeepsState)
+	{
+		DocumentLexer::LineState entryState;
+		entryState.context = DocumentLexer::Context::rawString;
+		entryState.delimiter = "x";
+		std::vector<DocumentLexer::Run> runs;
+		auto state = DocumentLexer::LexLine("", entryState, runs);
+		Assert::IsTrue(state == entryState);
+		Assert::IsTrue(runs.empty());
+	}
+
+	TEST_METHOD(RawStringEndsAtMatchingDelimiter)
+	{
+		std::vector<DocumentLexer::Run> runs;
+		auto state = DocumentLexer::LexLine("auto s = u8R\"ab(text)\"", DocumentLexer::LineState(), runs);
+		Assert::IsTrue(state.context == DocumentLexer::Context::rawString);
+		Assert::AreEqual(std::string("ab"), state.delimiter);
+		AssertRun(runs.back(), 9, 13, DocumentLexer::Token::string);
+
+		state = DocumentLexer::LexLine("\"// )ab\"; // x", state, runs);
+		Assert::IsTrue(state.context == DocumentLexer::Context::code);
+		AssertRun(runs[0], 0, 8, DocumentLexer::Token::string);
+		AssertRun(runs[1], 8, 1, DocumentLexer::Token::punctuation);
+		AssertRun(runs.back(), 10, 4, DocumentLexer::Token::comment);
+	}
+
+	TEST_METHOD(IdentifierEndingInRIsNotRawString)
+	{
+		std::vector<DocumentLexer::Run> runs;
+		auto state = DocumentLexer::LexLine("FOR\"(\"", DocumentLexer::LineState(), runs);
+		Assert::IsTrue(state.context == DocumentLexer::Context::code);
+		Assert::AreEqual(2ul, static_cast<unsigned long>(runs.size()));
+		AssertRun(runs[0], 0, 3, DocumentLexer::Token::text);
+		AssertRun(runs[1], 3, 3, DocumentLexer::Token::string);
+	}
+
+	TEST_METHOD(LargeSourceLexesIntoFewRuns)
+	{
+		//Each run is one text output call when painting, the old painter made one per character
+		const std::vector<std::string> lines = {
+			"#include \"DocumentLexer.h\"",
+			"",
+			"bool DocumentLexer::IsTypeKeyword(const std::string& word) const",
+			"{",
+			"\tauto index = word.find_first_of(\"_\", 0); // first separator",
+			"\tif (index == std::string::npos && word.size() > 42)",
+			"\t\treturn static_cast<unsigned long>(index) < 0x7fff;",
+			"\t/* unreachable */ return false;",
+			"}"
+		};
+		unsigned long characterCount = 0;
+		unsigned long runCount = 0;
+		std::vector<DocumentLexer::Run> runs;
+		DocumentLexer::LineState state;
+
+		auto start = std::chrono::steady_clock::now();
+		while (characterCount < 4 * 1024 * 1024)
+			for (const auto& line: lines)
+			{
+				state = DocumentLexer::LexLine(line, state, runs);
+				characterCount += line.size();
+				runCount += runs.size();
+			}
+		auto lexTime = std::chrono::steady_clock::now() - start;
+
+		Assert::IsTrue(state.context == DocumentLexer::Context::code);
+		Assert::IsTrue(runCount * 3 < characterCount);
+
+		//Tests run in parallel, so the timing is only reported (the runner reads the result from standard output)
+		std::cerr << "Lexed " << characterCount << " characters in "
+			<< std::chrono::duration_cast<std::chrono::microseconds>(lexTime).count() << " us" << std::endl;
+	}
+
+private:
+	static void AssertRun(const DocumentLexer::Run& run, unsigned long start, unsigned long length, DocumentLexer::Token token)
+	{
+		Assert::AreEqual(start, run.start);
+		Assert::AreEqual(length, run.length);
+		Assert::IsTrue(run.token == token);
+	}
+};
@@ -0,0 +1,316 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    DocumentLexer.cpp
+// Description: This file implements all DocumentLexer member functions.
+//
+// Created:     2026-10-17 14:02:37
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#include "pch.h"
+#include "DocumentLexer.h"
+#include "DocumentKeywords.h"
+#include <cctype>
+#include <cstring>
+
+bool DocumentLexer::LineState::operator==(const LineState& rhs) const
+{
+	return context == rhs.context && delimiter == rhs.delimiter;
+}
+
+bool DocumentLexer::LineState::operator!=(const LineState& rhs) const
+{
+	return !(*this == rhs);
+}
+
+DocumentLexer::LineState DocumentLexer::LexLine(const std::string& text, const LineState& entryState, std::vector<Run>& runs)
+{
+	return LexLine(text.data(), text.size(), entryState, runs);
+}
+
+DocumentLexer::LineState DocumentLexer::LexLine(const char* text, unsigned long length, const LineState& entryState, std::vector<Run>& runs)
+{
+	DocumentLexer lexer(text, length, entryState);
+	runs.clear();
+	for (unsigned long index = 0; index < length; ++index)
+	{
+		lexer.TransitionState(index);
+		auto token = GetStateToken(lexer.state);
+		if (!runs.empty() && runs.back().token == token)
+			++runs.back().length;
+		else
+			runs.push_back({ index, 1, token });
+	}
+	return lexer.GetLineState();
+}
+
+DocumentLexer::DocumentLexer(const char* text, unsigned long length, const LineState& entryState)
+	: text(text), length(length)
+{
+	if (entryState.context == Context::blockComment)
+		state = State::blockComment;
+	else if (entryState.context == Context::rawString)
+	{
+		state = State::rawString;
+		delimiter = entryState.delimiter;
+	}
+}
+
+void DocumentLexer::TransitionState(unsigned long index)
+{
+	auto c = text[index];
+	auto hasNext = (index + 1) < length;
+	auto next = hasNext ? text[index + 1] : '\0';
+
+	//Determine the state of the current character based on the previous state
+	switch(state)
+	{
+	case State::initial:
+		if (c == '#')
+			state = State::preprocessor;
+		else if (!std::isspace(c))
+		{
+			state = State::none;
+			goto case_state_none;
+		}
+		break;
+
+	case State::none:
+	case_state_none:
+		if (c == '"')
+			state = State::string;
+		else if (c == '\'')
+			state = State::character;
+		else if (c == '/' && hasNext && next == '/')
+			state = State::singleLineComment;
+		else if (c == '/' && hasNext && next == '*')
+			state = State::blockCommentStart;
+		else if (c == '_' || std::isalpha(c))
+		{
+			auto wordLength = ScanWord(index);
+			auto quote = index + wordLength;
+			auto token = DocumentKeywords::Classify(text + index, wordLength);
+			if (IsRawStringPrefix(index, wordLength) && quote < length && text[quote] == '"')
+			{
+				//The rest of the prefix and the opening quote follow this character
+				state = State::rawStringPrefix;
+				remaining = wordLength;
+				delimiter.clear();
+			}
+			else if (token == Token::instructionKeyword)
+				state = State::instructionKeyword;
+			else if (token == Token::typeKeyword)
+				state = State::typeKeyword;
+			else if ((isIf && IsWord(index, wordLength, "defined")) ||
+				(isPragma && IsWord(index, wordLength, "once")))
+				state = State::preprocessorKeyword;
+			else
+				state = State::identifier;
+		}
+		else if (isInclude && c == '<')
+			state = State::includeString;
+		else if (std::isdigit(c))
+			state = State::number;
+		else if (std::ispunct(c))
+			state = State::punctuation;
+		break;
+
+	case State::punctuation:
+	case State::stringEnd:
+	case State::characterEnd:
+	case State::blockCommentEnd:
+		state = State::none;
+		goto case_state_none;
+
+	case State::number:
+		if (!std::isalnum(c) && c != '.')
+		{
+			state = State::none;
+			goto case_state_none;
+		}
+		break;
+
+	case State::includeString:
+		if (c == '>')
+			state = State::includeStringEnd;
+		break;
+
+	case State::includeStringEnd:
+		state = State::none;
+		goto case_state_none;
+
+	case State::string:
+		if (c == '\\')
+			state = State::stringEscape;
+		else if (c == '"')
+			state = State::stringEnd;
+		break;
+
+	case State::stringEscape:
+		state = State::string;
+		break;
+
+	case State::character:
+		if (c == '\\')
+			state = State::characterEscape;
+		else if (c == '\'')
+			state = State::characterEnd;
+		break;
+
+	case State::characterEscape:
+		state = State::character;
+		break;
+
+	case State::blockCommentStart:
+		//This is the '*' of the opening so that "/*/" does not also close the comment
+		state = State::blockComment;
+		break;
+
+	case State::blockComment:
+		if (c == '*' && hasNext && next == '/')
+			state = State::blockCommentStar;
+		break;
+
+	case State::blockCommentStar:
+		state = State::blockCommentEnd;
+		break;
+
+	case State::rawStringPrefix:
+		if (--remaining == 0)
+			state = State::rawStringDelimiter;
+		break;
+
+	case State::rawStringDelimiter:
+		if (c == '(')
+			state = State::rawString;
+		else
+			delimiter += c;
+		break;
+
+	case State::rawString:
+		if (c == ')' &&
+			index + delimiter.size() + 1 < length &&
+			delimiter.compare(0, delimiter.size(), text + index + 1, delimiter.size()) == 0 &&
+			text[index + delimiter.size() + 1] == '"')
+		{
+			//The delimiter and the closing quote follow this character
+			state = State::rawStringEnd;
+			remaining = delimiter.size() + 1;
+		}
+		break;
+
+	case State::rawStringEnd:
+		if (--remaining == 0)
+			state = State::stringEnd;
+		break;
+
+	case State::instructionKeyword:
+	case State::typeKeyword:
+	case State::identifier:
+		if (c != '_' && !std::isalnum(c))
+		{
+			state = State::none;
+			goto case_state_none;
+		}
+		break;
+
+	case State::preprocessor:
+		if (!std::isspace(c))
+		{
+			auto wordLength = ScanWord(index);
+			if (IsWord(index, wordLength, "if"))
+				isIf = true;
+			else if (IsWord(index, wordLength, "pragma"))
+				isPragma = true;
+			else if (IsWord(index, wordLength, "include"))
+				isInclude = true;
+			state = State::preprocessorKeyword;
+		}
+		break;
+
+	case State::preprocessorKeyword:
+		if (!std::isalpha(c))
+		{
+			state = State::none;
+			goto case_state_none;
+		}
+		break;
+
+	case State::singleLineComment:
+		break;
+	}
+}
+
+DocumentLexer::LineState DocumentLexer::GetLineState() const
+{
+	//Only an open block comment or raw string carries over to the next line
+	LineState lineState;
+	if (state == State::blockCommentStart || state == State::blockComment)
+		lineState.context = Context::blockComment;
+	else if (state == State::rawString)
+	{
+		lineState.context = Context::rawString;
+		lineState.delimiter = delimiter;
+	}
+	return lineState;
+}
+
+DocumentLexer::Token DocumentLexer::GetStateToken(State state)
+{
+	switch(state)
+	{
+	case State::string:
+	case State::stringEscape:
+	case State::stringEnd:
+	case State::rawStringPrefix:
+	case State::rawStringDelimiter:
+	case State::rawString:
+	case State::rawStringEnd:
+	case State::includeString:
+	case State::includeStringEnd:
+	case State::character:
+	case State::characterEscape:
+	case State::characterEnd:
+		return Token::string;
+	case State::punctuation:
+		return Token::punctuation;
+	case State::number:
+		return Token::number;
+	case State::singleLineComment:
+	case State::blockCommentStart:
+	case State::blockComment:
+	case State::blockCommentStar:
+	case State::blockCommentEnd:
+		return Token::comment;
+	case State::instructionKeyword:
+		return Token::instructionKeyword;
+	case State::typeKeyword:
+		return Token::typeKeyword;
+	case State::preprocessor:
+	case State::preprocessorKeyword:
+		return Token::preprocessor;
+	default:
+		return Token::text;
+	}
+}
+
+unsigned long DocumentLexer::ScanWord(unsigned long index) const
+{
+	//Only the length is returned so that scanning a word never allocates
+	unsigned long end = index + 1;
+	while (end < length && (text[end] == '_' || std::isalnum(text[end])))
+		++end;
+	return end - index;
+}
+
+bool DocumentLexer::IsWord(unsigned long index, unsigned long wordLength, const char* word) const
+{
+	return std::strlen(word) == wordLength && std::memcmp(text + index, word, wordLength) == 0;
+}
+
+bool DocumentLexer::IsRawStringPrefix(unsigned long index, unsigned long wordLength) const
+{
+	return IsWord(index, wordLength, "R") ||
+		IsWord(index, wordLength, "LR") ||
+		IsWord(index, wordLength, "uR") ||
+		IsWord(index, wordLength, "UR") ||
+		IsWord(index, wordLength, "u8R");
+}
@@ -0,0 +1,109 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    DocumentLexer.h
+// Description: This file declares the DocumentLexer class.  The lexer splits a
+//              single line of C++ into runs of characters that share a token
+//              kind.  Block comments and raw strings can span lines, so each
+//              line is lexed from the state the previous line ended in and
+//              reports the state it ends in.
+//
+// Created:     2026-10-17 14:02:37
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <string>
+#include <vector>
+
+class DocumentLexer
+{
+public:
+	enum class Token : unsigned char
+	{
+		text,
+		punctuation,
+		number,
+		string,
+		comment,
+		instructionKeyword,
+		typeKeyword,
+		preprocessor
+	};
+
+	struct Run
+	{
+		unsigned long start;
+		unsigned long length;
+		Token token;
+	};
+
+	enum class Context : unsigned char
+	{
+		code,
+		blockComment,
+		rawString
+	};
+
+	struct LineState
+	{
+		Context context = Context::code;
+		std::string delimiter;
+
+		bool operator==(const LineState& rhs) const;
+		bool operator!=(const LineState& rhs) const;
+	};
+
+	static LineState LexLine(const std::string& text, const LineState& entryState, std::vector<Run>& runs);
+	static LineState LexLine(const char* text, unsigned long length, const LineState& entryState, std::vector<Run>& runs);
+
+private:
+	friend class DocumentLexerTest;
+
+	enum class State
+	{
+		initial,
+		none,
+		string,
+		stringEscape,
+		stringEnd,
+		character,
+		characterEscape,
+		characterEnd,
+		singleLineComment,
+		blockCommentStart,
+		blockComment,
+		blockCommentStar,
+		blockCommentEnd,
+		rawStringPrefix,
+		rawStringDelimiter,
+		rawString,
+		rawStringEnd,
+		instructionKeyword,
+		typeKeyword,
+		identifier,
+		preprocessor,
+		preprocessorKeyword,
+		includeString,
+		includeStringEnd,
+		number,
+		punctuation
+	};
+
+	DocumentLexer(const char* text, unsigned long length, const LineState& entryState);
+
+	void TransitionState(unsigned long index);
+	LineState GetLineState() const;
+
+	static Token GetStateToken(State state);
+	unsigned long ScanWord(unsigned long index) const;
+	bool IsWord(unsigned long index, unsigned long wordLength, const char* word) const;
+	bool IsRawStringPrefix(unsigned long index, unsigned long wordLength) const;
+
+private:
+	const char* text;
+	unsigned long length;
+	State state = State::initial;
+	bool isIf = false;
+	bool isInclude = false;
+	bool isPragma = false;
+	std::string delimiter;
+	unsigned long remaining = 0;
+};
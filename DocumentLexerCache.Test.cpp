@@ -0,0 +1,199 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    DocumentLexerCache.Test.cpp
+// Description: This file defines all DocumentLexerCache unit tests.
+//
+// Created:     2026-10-17 14:02:37
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#include "DocumentLexerCache.h"
+#include "DocumentPieceTable.h"
+#include <UnitTest/UnitTest.h>
+using UnitTest::Assert;
+
+TEST_CLASS(DocumentLexerCacheTest)
+{
+public:
+	DocumentLexerCacheTest()
+	{
+	}
+
+	TEST_METHOD(PaintedLinesAreLexedOnce)
+	{
+		DocumentPieceTable table;
+		table.Load(CreateLines(100));
+		DocumentLexerCache cache;
+		cache.GetRuns(table, 50);
+		Assert::AreEqual(51ul, cache.GetLexCount());
+		cache.GetRuns(table, 50);
+		cache.GetRuns(table, 10);
+		Assert::AreEqual(52ul, cache.GetLexCount());
+		Assert::IsFalse(cache.FindLine(20).hasRuns);
+	}
+
+	TEST_METHOD(EditStopsWhenStatesConverge)
+	{
+		DocumentPieceTable table;
+		table.Load(CreateLines(100));
+		DocumentLexerCache cache;
+		cache.GetRuns(table, 99);
+		auto lexCount = cache.GetLexCount();
+
+		table.ReplaceLine(10, "int changed;");
+		cache.ChangeLine(10);
+		cache.GetRuns(table, 99);
+		Assert::AreEqual(lexCount + 1, cache.GetLexCount());
+	}
+
+	TEST_METHOD(OpeningCommentRelexesUntilClosed)
+	{
+		DocumentPieceTable table;
+		table.Load(CreateLines(100));
+		DocumentLexerCache cache;
+		auto runs = cache.GetRuns(table, 99);
+		Assert::IsTrue(runs[0].token == DocumentLexer::Token::typeKeyword);
+		auto lexCount = cache.GetLexCount();
+
+		table.ReplaceLine(10, "/* opened");
+		cache.ChangeLine(10);
+		table.ReplaceLine(20, "closed */");
+		cache.ChangeLine(20);
+		runs = cache.GetRuns(table, 15);
+		Assert::AreEqual(1ul, static_cast<unsigned long>(runs.size()));
+		Assert::IsTrue(runs[0].token == DocumentLexer::Token::comment);
+		runs = cache.GetRuns(table, 99);
+		Assert::IsTrue(runs[0].token == DocumentLexer::Token::typeKeyword);
+		Assert::AreEqual(lexCount + 11, cache.GetLexCount());
+	}
+
+	TEST_METHOD(InsertAndEraseShiftLines)
+	{
+		DocumentPieceTable table;
+		table.Load(CreateLines(10));
+		DocumentLexerCache cache;
+		cache.GetRuns(table, 9);
+
+		table.InsertLines(5, { "/*", "*/" });
+		cache.InsertLines(5, 2);
+		Assert::AreEqual(12ul, cache.GetLineCount());
+		Assert::IsTrue(cache.GetRuns(table, 6)[0].token == DocumentLexer::Token::comment);
+		Assert::IsTrue(cache.GetRuns(table, 7)[0].token == DocumentLexer::Token::typeKeyword);
+
+		table.EraseLines(6, 1);
+		cache.EraseLines(6, 1);
+		Assert::AreEqual(11ul, cache.GetLineCount());
+		Assert::IsTrue(cache.GetRuns(table, 10)[0].token == DocumentLexer::Token::comment);
+	}
+
+	TEST_METHOD(SettleFindsWhereColorsConverge)
+	{
+		DocumentPieceTable table;
+		table.Load(CreateLines(100));
+		DocumentLexerCache cache;
+		cache.GetRuns(table, 99);
+
+		table.ReplaceLine(10, "int changed;");
+		cache.ChangeLine(10);
+		Assert::AreEqual(11ul, cache.Settle(table, 11, 50));
+
+		table.ReplaceLine(10, "/* opened");
+		cache.ChangeLine(10);
+		table.ReplaceLine(20, "closed */");
+		cache.ChangeLine(20);
+		Assert::AreEqual(21ul, cache.Settle(table, 11, 50));
+
+		table.ReplaceLine(30, "/* never closed");
+		cache.ChangeLine(30);
+		Assert::AreEqual(100ul, cache.Settle(table, 31, 5));
+	}
+
+	TEST_METHOD(MergedChunksAreNotLexedAgain)
+	{
+		DocumentPieceTable table;
+		table.Load(CreateLines(100));
+		table.ReplaceLine(10, "/* opened");
+		DocumentLexerCache cache;
+		DocumentLexerCache::Chunk chunk;
+		auto chunkCount = 0ul;
+		while (cache.GetNextChunk(table, 30, chunk))
+		{
+			LexChunk(chunk);
+			cache.MergeChunk(chunk);
+			++chunkCount;
+		}
+		Assert::AreEqual(4ul, chunkCount);
+		Assert::IsTrue(cache.GetRuns(table, 99)[0].token == DocumentLexer::Token::comment);
+		Assert::AreEqual(0ul, cache.GetLexCount());
+	}
+
+	TEST_METHOD(EditDiscardsChunk)
+	{
+		DocumentPieceTable table;
+		table.Load(CreateLines(100));
+		DocumentLexerCache cache;
+		DocumentLexerCache::Chunk chunk;
+		Assert::IsTrue(cache.GetNextChunk(table, 50, chunk));
+		LexChunk(chunk);
+
+		table.ReplaceLine(5, "/* opened");
+		cache.ChangeLine(5);
+		cache.MergeChunk(chunk);
+		Assert::IsFalse(cache.FindLine(0).hasRuns);
+		Assert::IsTrue(cache.GetNextChunk(table, 50, chunk));
+		Assert::AreEqual(0ul, chunk.firstLine);
+	}
+
+	TEST_METHOD(EditsOnlySplitTheirBlock)
+	{
+		DocumentPieceTable table;
+		table.Load(CreateLines(100000));
+		DocumentLexerCache cache;
+		cache.GetRuns(table, 99999);
+		auto blockCount = GetBlockCount(cache.root);
+
+		//Lines after the edit keep their runs where they moved to instead of being copied along
+		for (auto index = 0ul; index < 1000; ++index)
+		{
+			table.InsertLines(50000, { "int inserted;" });
+			cache.InsertLines(50000, 1);
+			table.EraseLines(60000, 1);
+			cache.EraseLines(60000, 1);
+		}
+		Assert::AreEqual(100000ul, cache.GetLineCount());
+		Assert::IsTrue(cache.FindLine(99999).hasRuns);
+		Assert::IsTrue(GetBlockCount(cache.root) <= blockCount + 4000);
+		Assert::IsTrue(GetDepth(cache.root) < 100ul);
+		Assert::IsTrue(cache.GetRuns(table, 50000)[0].token == DocumentLexer::Token::typeKeyword);
+	}
+
+private:
+	static std::vector<std::string> CreateLines(unsigned long count)
+	{
+		return std::vector<std::string>(count, "int value = 0;");
+	}
+
+	static void LexChunk(DocumentLexerCache::Chunk& chunk)
+	{
+		//Does the work of DocumentLexerThread on the calling thread
+		auto state = chunk.entryState;
+		for (unsigned long index = 0; index < chunk.lineTexts.size(); ++index)
+		{
+			chunk.runs.emplace_back();
+			state = DocumentLexer::LexLine(chunk.lineTexts[index], chunk.lineLengths[index], state, chunk.runs.back());
+			chunk.exitStates.push_back(state);
+		}
+	}
+
+	static unsigned long GetBlockCount(const DocumentLexerCache::BlockPtr& block)
+	{
+		return block ? GetBlockCount(block->left) + 1 + GetBlockCount(block->right) : 0;
+	}
+
+	static unsigned long GetDepth(const DocumentLexerCache::BlockPtr& block)
+	{
+		if (!block)
+			return 0;
+		auto leftDepth = GetDepth(block->left);
+		auto rightDepth = GetDepth(block->right);
+		return 1 + (leftDepth > rightDepth ? leftDepth : rightDepth);
+	}
+};
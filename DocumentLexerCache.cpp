@@ -0,0 +1,355 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    DocumentLexerCache.cpp
+// Description: This file implements all DocumentLexerCache member functions.
+//
+// Created:     2026-10-17 14:02:37
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#include "pch.h"
+#include "DocumentLexerCache.h"
+#include "DocumentStorage.h"
+
+const auto blockSize = 256ul;
+
+void DocumentLexerCache::Clear()
+{
+	root.reset();
+	lastBlock = nullptr;
+	delimiters.clear();
+	validCount = 0;
+	++version;
+}
+
+void DocumentLexerCache::ChangeLine(unsigned long index)
+{
+	++version;
+	if (index < GetLineCount())
+		Invalidate(index);
+}
+
+void DocumentLexerCache::InsertLines(unsigned long index, unsigned long count)
+{
+	//Inserted lines have no previous end state, so the line after them is always re-lexed
+	++version;
+	if (index < GetLineCount())
+	{
+		BlockPtr left, right;
+		lastBlock = nullptr;
+		Split(std::move(root), index, left, right);
+		root = Merge(Merge(std::move(left), CreateBlocks(count)), std::move(right));
+		validCount = MATH::Min(validCount, index);
+	}
+}
+
+void DocumentLexerCache::EraseLines(unsigned long index, unsigned long count)
+{
+	++version;
+	if (index < GetLineCount())
+	{
+		BlockPtr left, middle, right;
+		lastBlock = nullptr;
+		Split(std::move(root), index, left, middle);
+		Split(std::move(middle), count, middle, right);
+		root = Merge(std::move(left), std::move(right));
+		if (index < GetLineCount())
+			Invalidate(index);
+		validCount = MATH::Min(validCount, index);
+	}
+}
+
+const std::vector<DocumentLexer::Run>& DocumentLexerCache::GetRuns(const DocumentStorage& storage, unsigned long index)
+{
+	Extend(index + 1);
+
+	//Lines in front of the requested line only need their end state (it is the next line's start state).
+	//Lines whose start state did not change since they were lexed are skipped.
+	for (; validCount < index; ++validCount)
+	{
+		const auto& line = FindLine(validCount);
+		if (line.isStale)
+			Lex(storage, validCount, line.hasRuns);
+	}
+
+	auto& line = FindLine(index);
+	if (line.isStale || !line.hasRuns)
+		Lex(storage, index, true);
+	validCount = MATH::Max(validCount, index + 1);
+	return line.runs;
+}
+
+unsigned long DocumentLexerCache::GetLexCount() const
+{
+	return lexCount;
+}
+
+unsigned long DocumentLexerCache::Settle(const DocumentStorage& storage, unsigned long index, unsigned long maxLineCount)
+{
+	//Lex the lines from the given line until one keeps its start state.  The lines in between may be colored
+	//differently now (an edit opened a block comment), the returned line and the ones after it are not.
+	//A line that was never lexed has not been painted either, so there is nothing to recolor from there on.
+	auto lineCount = storage.GetLineCount();
+	Extend(lineCount);
+	for (; validCount < index; ++validCount)
+	{
+		const auto& line = FindLine(validCount);
+		if (line.isStale)
+			Lex(storage, validCount, line.hasRuns);
+	}
+
+	auto end = index;
+	for (; end < lineCount; ++end)
+	{
+		const auto& line = FindLine(end);
+		if (!line.isStale || !line.hasExitState)
+			break;
+		if (end - index == maxLineCount)
+			return lineCount;
+		Lex(storage, end, line.hasRuns);
+	}
+	validCount = MATH::Max(validCount, end);
+	return end;
+}
+
+bool DocumentLexerCache::GetNextChunk(const DocumentStorage& storage, unsigned long maxLineCount, Chunk& chunk)
+{
+	auto lineCount = storage.GetLineCount();
+	Extend(lineCount);
+
+	//Skip the lines that are already lexed, after an edit the chunk usually ends where the states converge
+	while (validCount < lineCount && IsLexed(validCount))
+		++validCount;
+	if (validCount >= lineCount)
+		return false;
+
+	chunk = Chunk();
+	chunk.version = version;
+	chunk.firstLine = validCount;
+	chunk.entryState = GetEntryState(validCount);
+	for (auto index = validCount; index < lineCount && chunk.lineTexts.size() < maxLineCount; ++index)
+	{
+		if (index > validCount && IsLexed(index))
+			break;
+		unsigned long length = 0;
+		chunk.lineTexts.push_back(storage.GetLineText(index, length));
+		chunk.lineLengths.push_back(length);
+	}
+	return true;
+}
+
+void DocumentLexerCache::MergeChunk(Chunk& chunk)
+{
+	//Any edit since the chunk was taken may have changed its lines or its start state
+	if (chunk.version != version || chunk.exitStates.size() != chunk.lineTexts.size())
+		return;
+
+	for (unsigned long index = 0; index < chunk.lineTexts.size(); ++index)
+		Store(chunk.firstLine + index, chunk.exitStates[index], std::move(chunk.runs[index]), true);
+	validCount = MATH::Max(validCount, chunk.firstLine + chunk.lineTexts.size());
+}
+
+unsigned long DocumentLexerCache::GetLineCount() const
+{
+	return LineCount(root);
+}
+
+DocumentLexerCache::Line& DocumentLexerCache::FindLine(unsigned long index)
+{
+	//Lines are mostly read in order, so the block of the previous lookup is tried first
+	if (lastBlock != nullptr && index >= lastBlockStart && index < lastBlockStart + lastBlock->lines.size())
+		return lastBlock->lines[index - lastBlockStart];
+
+	//Walk down the tree using the subtree line counts to find the block holding the line
+	auto block = root.get();
+	auto blockStart = 0ul;
+	for (;;)
+	{
+		auto leftCount = LineCount(block->left);
+		if (index < blockStart + leftCount)
+		{
+			block = block->left.get();
+		}
+		else if (index < blockStart + leftCount + block->lines.size())
+		{
+			lastBlock = block;
+			lastBlockStart = blockStart + leftCount;
+			return block->lines[index - lastBlockStart];
+		}
+		else
+		{
+			blockStart += leftCount + block->lines.size();
+			block = block->right.get();
+		}
+	}
+}
+
+bool DocumentLexerCache::IsLexed(unsigned long index)
+{
+	const auto& line = FindLine(index);
+	return !line.isStale && line.hasRuns;
+}
+
+void DocumentLexerCache::Extend(unsigned long lineCount)
+{
+	//Lines that were never requested are added to the end (they have not been lexed yet)
+	auto count = GetLineCount();
+	if (count < lineCount)
+	{
+		lastBlock = nullptr;
+		root = Merge(std::move(root), CreateBlocks(lineCount - count));
+	}
+}
+
+DocumentLexerCache::BlockPtr DocumentLexerCache::CreateBlock(std::vector<Line>&& lines)
+{
+	BlockPtr block(new Block());
+	block->lines = std::move(lines);
+	block->lineCount = block->lines.size();
+	block->priority = random();
+	return block;
+}
+
+DocumentLexerCache::BlockPtr DocumentLexerCache::CreateBlocks(unsigned long count)
+{
+	BlockPtr blocks;
+	while (count > 0)
+	{
+		auto size = MATH::Min(count, blockSize);
+		blocks = Merge(std::move(blocks), CreateBlock(std::vector<Line>(size)));
+		count -= size;
+	}
+	return blocks;
+}
+
+void DocumentLexerCache::Split(BlockPtr block, unsigned long lines, BlockPtr& left, BlockPtr& right)
+{
+	if (!block)
+	{
+		left.reset();
+		right.reset();
+		return;
+	}
+
+	auto leftCount = LineCount(block->left);
+	if (lines <= leftCount)
+	{
+		//The split point is entirely within the left subtree
+		BlockPtr leftRight;
+		Split(std::move(block->left), lines, left, leftRight);
+		block->left = std::move(leftRight);
+		Update(block.get());
+		right = std::move(block);
+	}
+	else if (lines >= leftCount + block->lines.size())
+	{
+		//The split point is entirely within the right subtree
+		BlockPtr rightLeft;
+		Split(std::move(block->right), lines - leftCount - block->lines.size(), rightLeft, right);
+		block->right = std::move(rightLeft);
+		Update(block.get());
+		left = std::move(block);
+	}
+	else
+	{
+		//The split point is inside of this block, so its tail moves to a new block that is merged with the right subtree
+		auto offset = block->lines.begin() + (lines - leftCount);
+		auto tail = CreateBlock(std::vector<Line>(std::make_move_iterator(offset), std::make_move_iterator(block->lines.end())));
+		block->lines.erase(offset, block->lines.end());
+		right = Merge(std::move(tail), std::move(block->right));
+		Update(block.get());
+		left = std::move(block);
+	}
+}
+
+void DocumentLexerCache::Invalidate(unsigned long index)
+{
+	auto& line = FindLine(index);
+	line.isStale = true;
+	line.hasRuns = false;
+	std::vector<DocumentLexer::Run>().swap(line.runs);
+	validCount = MATH::Min(validCount, index);
+}
+
+DocumentLexer::LineState DocumentLexerCache::GetEntryState(unsigned long index)
+{
+	DocumentLexer::LineState entryState;
+	if (index > 0)
+	{
+		const auto& line = FindLine(index - 1);
+		entryState.context = line.context;
+		if (line.context == DocumentLexer::Context::rawString)
+			entryState.delimiter = delimiters[line.delimiter];
+	}
+	return entryState;
+}
+
+void DocumentLexerCache::Lex(const DocumentStorage& storage, unsigned long index, bool keepRuns)
+{
+	std::vector<DocumentLexer::Run> runs;
+	unsigned long length = 0;
+	auto text = storage.GetLineText(index, length);
+	auto exitState = DocumentLexer::LexLine(text, length, GetEntryState(index), runs);
+	++lexCount;
+	Store(index, exitState, std::move(runs), keepRuns);
+}
+
+void DocumentLexerCache::Store(unsigned long index, const DocumentLexer::LineState& exitState, std::vector<DocumentLexer::Run>&& runs, bool keepRuns)
+{
+	auto& line = FindLine(index);
+	unsigned short delimiter = exitState.context == DocumentLexer::Context::rawString ? FindDelimiter(exitState.delimiter) : 0;
+
+	//A different end state changes how the next line starts, so it has to be lexed again as well
+	auto isChanged = !line.hasExitState || exitState.context != line.context || delimiter != line.delimiter;
+	line.context = exitState.context;
+	line.delimiter = delimiter;
+	line.hasExitState = true;
+	line.isStale = false;
+	line.hasRuns = keepRuns;
+	if (keepRuns)
+	{
+		line.runs = std::move(runs);
+		line.runs.shrink_to_fit();
+	}
+	else
+		std::vector<DocumentLexer::Run>().swap(line.runs);
+
+	if (isChanged && index + 1 < GetLineCount())
+		Invalidate(index + 1);
+}
+
+unsigned short DocumentLexerCache::FindDelimiter(const std::string& delimiter)
+{
+	auto iter = std::find(delimiters.begin(), delimiters.end(), delimiter);
+	if (iter != delimiters.end())
+		return iter - delimiters.begin();
+	delimiters.push_back(delimiter);
+	return delimiters.size() - 1;
+}
+
+unsigned long DocumentLexerCache::LineCount(const BlockPtr& block)
+{
+	return block ? block->lineCount : 0;
+}
+
+void DocumentLexerCache::Update(Block* block)
+{
+	block->lineCount = LineCount(block->left) + block->lines.size() + LineCount(block->right);
+}
+
+DocumentLexerCache::BlockPtr DocumentLexerCache::Merge(BlockPtr left, BlockPtr right)
+{
+	if (!left)
+		return right;
+	if (!right)
+		return left;
+
+	if (left->priority > right->priority)
+	{
+		left->right = Merge(std::move(left->right), std::move(right));
+		Update(left.get());
+		return left;
+	}
+
+	right->left = Merge(std::move(left), std::move(right->left));
+	Update(right.get());
+	return right;
+}
@@ -0,0 +1,103 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    DocumentLexerCache.h
+// Description: This file declares the DocumentLexerCache class.  The cache
+//              keeps the state each line ends in and its token runs so an
+//              edit only re-lexes the changed lines and the lines after them
+//              until the end states converge.  The whole document is lexed in
+//              chunks by a background pass (see DocumentLexerThread) so
+//              painting normally only reads the cache.  The lines are kept in
+//              blocks held in a treap ordered by line position (the same shape
+//              as DocumentPieceTable), so inserting or erasing lines only splits
+//              the block at the edit instead of moving every line after it.
+//
+// Created:     2026-10-17 14:02:37
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <string>
+#include <vector>
+#include <memory>
+#include <random>
+#include "DocumentLexer.h"
+
+class DocumentStorage;
+
+class DocumentLexerCache
+{
+public:
+	struct Chunk
+	{
+		unsigned long version = 0;
+		unsigned long firstLine = 0;
+		DocumentLexer::LineState entryState;
+		std::vector<const char*> lineTexts;
+		std::vector<unsigned long> lineLengths;
+		std::vector<DocumentLexer::LineState> exitStates;
+		std::vector<std::vector<DocumentLexer::Run>> runs;
+	};
+
+	void Clear();
+	void ChangeLine(unsigned long index);
+	void InsertLines(unsigned long index, unsigned long count);
+	void EraseLines(unsigned long index, unsigned long count);
+
+	const std::vector<DocumentLexer::Run>& GetRuns(const DocumentStorage& storage, unsigned long index);
+	unsigned long GetLexCount() const;
+	unsigned long Settle(const DocumentStorage& storage, unsigned long index, unsigned long maxLineCount);
+
+	bool GetNextChunk(const DocumentStorage& storage, unsigned long maxLineCount, Chunk& chunk);
+	void MergeChunk(Chunk& chunk);
+
+private:
+	friend class DocumentLexerCacheTest;
+
+	//Raw string delimiters are kept once in a side table so each line stays small
+	struct Line
+	{
+		std::vector<DocumentLexer::Run> runs;
+		DocumentLexer::Context context = DocumentLexer::Context::code;
+		unsigned short delimiter = 0;
+		bool hasExitState = false;
+		bool hasRuns = false;
+		bool isStale = true;
+	};
+
+	struct Block;
+	typedef std::unique_ptr<Block> BlockPtr;
+
+	struct Block
+	{
+		std::vector<Line> lines;
+		unsigned long lineCount = 0;
+		unsigned int priority = 0;
+		BlockPtr left;
+		BlockPtr right;
+	};
+
+	unsigned long GetLineCount() const;
+	Line& FindLine(unsigned long index);
+	bool IsLexed(unsigned long index);
+	void Extend(unsigned long lineCount);
+	BlockPtr CreateBlock(std::vector<Line>&& lines);
+	BlockPtr CreateBlocks(unsigned long count);
+	void Split(BlockPtr block, unsigned long lines, BlockPtr& left, BlockPtr& right);
+	void Invalidate(unsigned long index);
+	DocumentLexer::LineState GetEntryState(unsigned long index);
+	void Lex(const DocumentStorage& storage, unsigned long index, bool keepRuns);
+	void Store(unsigned long index, const DocumentLexer::LineState& exitState, std::vector<DocumentLexer::Run>&& runs, bool keepRuns);
+	unsigned short FindDelimiter(const std::string& delimiter);
+
+	static unsigned long LineCount(const BlockPtr& block);
+	static void Update(Block* block);
+	static BlockPtr Merge(BlockPtr left, BlockPtr right);
+
+private:
+	BlockPtr root;
+	Block* lastBlock = nullptr;
+	unsigned long lastBlockStart = 0;
+	std::minstd_rand random;
+	std::vector<std::string> delimiters;
+	unsigned long validCount = 0;
+	unsigned long lexCount = 0;
+	unsigned long version = 0;
+};
@@ -0,0 +1,53 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    DocumentLexerThread.cpp
+// Description: This file implements all DocumentLexerThread member functions.
+//
+// Created:     2026-10-17 15:58:40
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#include "pch.h"
+#include "DocumentLexerThread.h"
+#include "Trace.h"
+
+DocumentLexerThread::DocumentLexerThread(DocumentLexerCache::Chunk&& chunk)
+	: chunk(std::move(chunk)), stopping(false), done(false)
+{
+	Start();
+}
+
+DocumentLexerThread::~DocumentLexerThread()
+{
+	//The lines are about to change, stop at the next line boundary
+	stopping = true;
+	Stop();
+}
+
+void DocumentLexerThread::Run()
+{
+	//Coloring lines nobody is looking at yet should not compete with the UI or a build
+	::SetThreadPriority(::GetCurrentThread(), THREAD_PRIORITY_BELOW_NORMAL);
+	Trace::Span trace("lex");
+
+	auto state = chunk.entryState;
+	chunk.exitStates.reserve(chunk.lineTexts.size());
+	chunk.runs.reserve(chunk.lineTexts.size());
+	for (unsigned long index = 0; index < chunk.lineTexts.size(); ++index)
+	{
+		if (stopping)
+			return;
+		chunk.runs.emplace_back();
+		state = DocumentLexer::LexLine(chunk.lineTexts[index], chunk.lineLengths[index], state, chunk.runs.back());
+		chunk.exitStates.push_back(state);
+	}
+	done = true;
+}
+
+bool DocumentLexerThread::IsDone() const
+{
+	return done;
+}
+
+DocumentLexerCache::Chunk& DocumentLexerThread::GetChunk()
+{
+	return chunk;
+}
@@ -0,0 +1,37 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    DocumentLexerThread.h
+// Description: This file declares the DocumentLexerThread class.  This thread
+//              lexes one chunk of lines at a low priority.  The chunk points
+//              at line text owned by the document storage, so the document
+//              stops the thread before it edits or reloads its lines.
+//
+// Created:     2026-10-17 15:58:40
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "BaseThread.h"
+#include "DocumentLexerCache.h"
+#include <atomic>
+#include <memory>
+
+class DocumentLexerThread : public BaseThread
+{
+public:
+	DocumentLexerThread(DocumentLexerCache::Chunk&& chunk);
+	DocumentLexerThread(const DocumentLexerThread& rhs) = delete;
+	~DocumentLexerThread();
+
+	DocumentLexerThread& operator=(const DocumentLexerThread& rhs) = delete;
+
+	void Run() final;
+
+	bool IsDone() const;
+	DocumentLexerCache::Chunk& GetChunk();
+
+private:
+	DocumentLexerCache::Chunk chunk;
+	std::atomic<bool> stopping;
+	std::atomic<bool> done;
+};
+
+typedef std::unique_ptr<DocumentLexerThread> DocumentLexerThreadPtr;
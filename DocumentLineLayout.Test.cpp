@@ -0,0 +1,78 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    DocumentLineLayout.Test.cpp
+// Description: This file defines all DocumentLineLayout unit tests.
+//
+// Created:     2026-10-17 12:48:22
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#include "DocumentLineLayout.h"
+#include <UnitTest/UnitTest.h>
+#include <random>
+using UnitTest::Assert;
+
+TEST_CLASS(DocumentLineLayoutTest)
+{
+public:
+	DocumentLineLayoutTest()
+	{
+	}
+
+	TEST_METHOD(TabFreeLineIsIdentity)
+	{
+		DocumentLineLayout layout("int main()");
+		Assert::IsTrue(layout.IsTabFree());
+		Assert::AreEqual(10ul, layout.GetColumnWidth());
+		Assert::AreEqual(4ul, layout.GetColumnFromIndex(4));
+		Assert::AreEqual(4ul, layout.GetIndexFromColumn(4));
+		Assert::AreEqual(10ul, layout.GetIndexFromColumn(25));
+	}
+
+	TEST_METHOD(TabsAdvanceToNextStop)
+	{
+		DocumentLineLayout layout("\tab\tc");
+		Assert::IsFalse(layout.IsTabFree());
+		Assert::AreEqual(9ul, layout.GetColumnWidth());
+		Assert::AreEqual(4ul, layout.GetColumnFromIndex(1));
+		Assert::AreEqual(8ul, layout.GetColumnFromIndex(4));
+		Assert::AreEqual(1ul, layout.GetIndexFromColumn(2));
+		Assert::AreEqual(3ul, layout.GetIndexFromColumn(6));
+		Assert::AreEqual(4ul, layout.GetIndexFromColumn(8));
+	}
+
+	TEST_METHOD(RandomLinesMatchColumnWalk)
+	{
+		std::mt19937 random(4321);
+		for (auto iteration = 0; iteration < 500; ++iteration)
+		{
+			std::string line;
+			auto size = random() % 40;
+			for (auto index = 0ul; index < size; ++index)
+				line += random() % 3 == 0 ? '\t' : 'x';
+
+			DocumentLineLayout layout(line);
+			Assert::AreEqual(WalkColumn(line, line.size()), layout.GetColumnWidth());
+			for (auto index = 0ul; index <= line.size(); ++index)
+				Assert::AreEqual(WalkColumn(line, index), layout.GetColumnFromIndex(index));
+			for (auto column = 0ul; column <= layout.GetColumnWidth() + 2; ++column)
+				Assert::AreEqual(WalkIndex(line, column), layout.GetIndexFromColumn(column));
+		}
+	}
+
+private:
+	static unsigned long WalkColumn(const std::string& line, unsigned long index)
+	{
+		auto column = 0ul;
+		for (auto position = 0ul; position < index; ++position)
+			column = line[position] == '\t' ? column + 4 - (column % 4) : column + 1;
+		return column;
+	}
+
+	static unsigned long WalkIndex(const std::string& line, unsigned long column)
+	{
+		for (auto index = 0ul; index < line.size(); ++index)
+			if (WalkColumn(line, index) >= column)
+				return index;
+		return line.size();
+	}
+};
+
@@ -0,0 +1,57 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    DocumentLineLayout.cpp
+// Description: This file implements all DocumentLineLayout member functions.
+//
+// Created:     2026-10-17 12:48:22
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#include "pch.h"
+#include "DocumentLineLayout.h"
+#include <algorithm>
+
+DocumentLineLayout::DocumentLineLayout(const std::string& line)
+	: length(line.size())
+{
+	for (auto position = line.find('\t'); position != std::string::npos; position = line.find('\t', position + 1))
+	{
+		//Column before the tab is the column after the previous tab plus the characters between them
+		auto column = tabIndices.empty() ? position : tabColumns.back() + (position - tabIndices.back() - 1);
+		tabIndices.push_back(position);
+		tabColumns.push_back(column + 4 - (column % 4));
+	}
+}
+
+bool DocumentLineLayout::IsTabFree() const
+{
+	return tabIndices.empty();
+}
+
+unsigned long DocumentLineLayout::GetColumnWidth() const
+{
+	return GetColumnFromIndex(length);
+}
+
+unsigned long DocumentLineLayout::GetColumnFromIndex(unsigned long index) const
+{
+	//Find the last tab before the index, every character after it is one column wide
+	auto tab = std::lower_bound(tabIndices.begin(), tabIndices.end(), index);
+	if (tab == tabIndices.begin())
+		return index;
+	auto previous = tab - tabIndices.begin() - 1;
+	return tabColumns[previous] + (index - tabIndices[previous] - 1);
+}
+
+unsigned long DocumentLineLayout::GetIndexFromColumn(unsigned long column) const
+{
+	//Find the first tab that reaches the column, the index lies in the run of characters
+	//between the previous tab and this one (or just after this tab if it spans the column)
+	auto tab = std::lower_bound(tabColumns.begin(), tabColumns.end(), column);
+	auto segment = tab - tabColumns.begin();
+	auto startIndex = segment == 0 ? 0 : tabIndices[segment - 1] + 1;
+	auto startColumn = segment == 0 ? 0 : tabColumns[segment - 1];
+	auto index = startIndex + (column - startColumn);
+	if (tab != tabColumns.end())
+		index = std::min(index, tabIndices[segment] + 1);
+	return std::min(index, length);
+}
+
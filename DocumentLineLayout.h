@@ -0,0 +1,32 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    DocumentLineLayout.h
+// Description: This file declares the DocumentLineLayout class.  This class
+//              records the tab stop layout of a single line (the index and the
+//              following column of each tab) so that column/index translation
+//              is a binary search instead of a walk from the start of the line.
+//              Lines without tabs store nothing and translate as the identity.
+//
+// Created:     2026-10-17 12:48:22
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <string>
+#include <vector>
+
+class DocumentLineLayout
+{
+public:
+	explicit DocumentLineLayout(const std::string& line);
+
+	bool IsTabFree() const;
+	unsigned long GetColumnWidth() const;
+	unsigned long GetColumnFromIndex(unsigned long index) const;
+	unsigned long GetIndexFromColumn(unsigned long column) const;
+
+private:
+	friend class DocumentLineLayoutTest;
+	unsigned long length;
+	std::vector<unsigned long> tabIndices;
+	std::vector<unsigned long> tabColumns;
+};
+
@@ -0,0 +1,86 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    DocumentMappedFile.Test.cpp
+// Description: This file defines all DocumentMappedFile unit tests.
+//
+// Created:     2026-10-17 10:02:37
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#include "DocumentMappedFile.h"
+#include <UnitTest/UnitTest.h>
+#include <fstream>
+using UnitTest::Assert;
+
+TEST_CLASS(DocumentMappedFileTest)
+{
+public:
+	DocumentMappedFileTest()
+	{
+	}
+
+	TEST_METHOD(IndexLinesMatchesGetline)
+	{
+		std::string text = "int main()\r\n{\r\n\treturn 0;   \r\n\r\n}";
+		std::vector<unsigned long> lineStarts, lineLengths;
+		DocumentMappedFile::IndexLines(text.data(), text.data() + text.size(), true, lineStarts, lineLengths);
+		Assert::AreEqual(5ul, static_cast<unsigned long>(lineStarts.size()));
+		Assert::AreEqual(std::string("\treturn 0;"), text.substr(lineStarts[2], lineLengths[2]));
+		Assert::AreEqual(0ul, lineLengths[3]);
+		Assert::AreEqual(std::string("}"), text.substr(lineStarts[4], lineLengths[4]));
+	}
+
+	TEST_METHOD(IndexLinesTrailingNewLine)
+	{
+		//Long lines exercise the 16 byte block scan as well as the tail scan
+		std::string longLine(100, 'x');
+		std::string text = longLine + "\n" + longLine + "\n";
+		std::vector<unsigned long> lineStarts, lineLengths;
+		DocumentMappedFile::IndexLines(text.data(), text.data() + text.size(), true, lineStarts, lineLengths);
+		Assert::AreEqual(2ul, static_cast<unsigned long>(lineStarts.size()));
+		Assert::AreEqual(101ul, lineStarts[1]);
+		Assert::AreEqual(100ul, lineLengths[1]);
+	}
+
+	TEST_METHOD(IndexLinesWithoutTrimming)
+	{
+		std::string text = "\treturn 0;   \r\n  \r\n}";
+		std::vector<unsigned long> lineStarts, lineLengths;
+		DocumentMappedFile::IndexLines(text.data(), text.data() + text.size(), false, lineStarts, lineLengths);
+		Assert::AreEqual(3ul, static_cast<unsigned long>(lineStarts.size()));
+		Assert::AreEqual(std::string("\treturn 0;   "), text.substr(lineStarts[0], lineLengths[0]));
+		Assert::AreEqual(std::string("  "), text.substr(lineStarts[1], lineLengths[1]));
+		Assert::AreEqual(std::string("}"), text.substr(lineStarts[2], lineLengths[2]));
+	}
+
+	TEST_METHOD(OnlyRecentLinesAreKept)
+	{
+		{
+			std::ofstream out("OnlyRecentLinesAreKept.txt");
+			for (auto index = 0; index < 10000; ++index)
+				out << "line " << index << std::endl;
+		}
+		DocumentMappedFile file;
+		Assert::IsTrue(file.Open("OnlyRecentLinesAreKept.txt", 0, true));
+		file.IndexChunk(1024);
+		while (!file.IndexChunk(1024))
+			;
+
+		//Scrolling through the whole file only keeps the most recent lines
+		for (auto index = 0ul; index < file.GetLineCount(); ++index)
+			Assert::AreEqual("line " + std::to_string(index), file.GetLine(index));
+		auto lineCount = static_cast<unsigned long>(file.lines.size());
+		Assert::IsTrue(lineCount > 0 && lineCount < 5000);
+		Assert::AreEqual(lineCount, static_cast<unsigned long>(file.lineIndex.size()));
+
+		//A line that is read again is moved to the front instead of being dropped
+		const auto& line = file.GetLine(9000);
+		for (auto index = 0ul; index < lineCount - 1; ++index)
+			file.GetLine(index);
+		Assert::AreEqual(std::string("line 9000"), line);
+		Assert::AreEqual(std::string("line 0"), file.GetLine(0));
+
+		file.Close();
+		Assert::AreEqual(0ul, static_cast<unsigned long>(file.lines.size()));
+		::DeleteFile("OnlyRecentLinesAreKept.txt");
+	}
+};
+
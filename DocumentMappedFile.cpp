@@ -0,0 +1,204 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    DocumentMappedFile.cpp
+// Description: This file implements all DocumentMappedFile member functions.
+//
+// Created:     2026-10-17 10:02:37
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#include "pch.h"
+#include "DocumentMappedFile.h"
+#include <cstring>
+#include <cctype>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+//Decoded lines kept for GetLine (several screens plus the lines being edited or searched)
+const auto maxCachedLines = 4096ul;
+
+DocumentMappedFile::~DocumentMappedFile()
+{
+	Close();
+}
+
+bool DocumentMappedFile::Open(const std::string& fileName, unsigned long minimumSize, bool trimWhitespace)
+{
+	constexpr auto trace = __PRETTY_FUNCTION__;
+	Close();
+
+	//A missing file is not an error (the caller falls back to an empty document)
+	auto fileHandle = ::CreateFile(
+		fileName.c_str(),
+		GENERIC_READ,
+		FILE_SHARE_READ | FILE_SHARE_DELETE,
+		nullptr,
+		OPEN_EXISTING,
+		FILE_FLAG_SEQUENTIAL_SCAN,
+		nullptr);
+	if (fileHandle == INVALID_HANDLE_VALUE)
+		return false;
+	file.Attach(fileHandle);
+
+	//Empty files cannot be mapped and line offsets are 32 bit, let the caller read those the old way
+	LARGE_INTEGER size = {0};
+	ERR::CheckWindowsError(!::GetFileSizeEx(file.Get(), &size), trace, "GetFileSizeEx");
+	if (size.QuadPart == 0 || size.QuadPart < static_cast<LONGLONG>(minimumSize) || size.HighPart != 0)
+	{
+		Close();
+		return false;
+	}
+
+	auto mappingHandle = ::CreateFileMapping(file.Get(), nullptr, PAGE_READONLY, 0, 0, nullptr);
+	ERR::CheckWindowsError(mappingHandle == nullptr, trace, "CreateFileMapping");
+	mapping.Attach(mappingHandle);
+
+	view = static_cast<const char*>(::MapViewOfFile(mapping.Get(), FILE_MAP_READ, 0, 0, 0));
+	ERR::CheckWindowsError(view == nullptr, trace, "MapViewOfFile");
+	this->size = size.LowPart;
+	this->trimWhitespace = trimWhitespace;
+	return true;
+}
+
+void DocumentMappedFile::Close()
+{
+	if (view != nullptr)
+		::UnmapViewOfFile(view);
+	view = nullptr;
+	size = 0;
+	indexedSize = 0;
+	mapping.Release();
+	file.Release();
+	lineStarts.clear();
+	lineLengths.clear();
+	lineCount = 0;
+	indexed = false;
+	lines.clear();
+	lineIndex.clear();
+}
+
+bool DocumentMappedFile::IndexChunk(unsigned long chunkSize)
+{
+	if (indexed)
+		return true;
+
+	//Extend the chunk to the end of the line it stops in so lines are never split between chunks
+	auto begin = view + indexedSize;
+	auto end = view + size;
+	auto chunkEnd = begin + MATH::Min(chunkSize, size - indexedSize);
+	if (chunkEnd < end)
+		chunkEnd = MATH::Min(FindNewLine(chunkEnd, end) + 1, end);
+
+	std::vector<unsigned long> chunkStarts, chunkLengths;
+	IndexLines(begin, chunkEnd, trimWhitespace, chunkStarts, chunkLengths);
+	for (auto& start: chunkStarts)
+		start += indexedSize;
+	indexedSize = chunkEnd - view;
+
+	//Publish the new lines, the vectors may reallocate so readers take the same lock
+	{
+		std::lock_guard<std::mutex> lock(indexLock);
+		lineStarts.insert(lineStarts.end(), chunkStarts.begin(), chunkStarts.end());
+		lineLengths.insert(lineLengths.end(), chunkLengths.begin(), chunkLengths.end());
+	}
+	lineCount = lineStarts.size();
+	indexed = indexedSize == size;
+	return indexed;
+}
+
+bool DocumentMappedFile::IsIndexed() const
+{
+	return indexed;
+}
+
+unsigned long DocumentMappedFile::GetLineCount() const
+{
+	return lineCount;
+}
+
+unsigned long DocumentMappedFile::GetLineLength(unsigned long index) const
+{
+	std::lock_guard<std::mutex> lock(indexLock);
+	return lineLengths[index];
+}
+
+const std::string& DocumentMappedFile::GetLine(unsigned long index) const
+{
+	//The lines are kept in most recently used order, moving one to the front does not move its string
+	auto iter = lineIndex.find(index);
+	if (iter != lineIndex.end())
+	{
+		lines.splice(lines.begin(), lines, iter->second);
+		return iter->second->second;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(indexLock);
+		lines.emplace_front(index, std::string(view + lineStarts[index], lineLengths[index]));
+	}
+	lineIndex.insert({ index, lines.begin() });
+	if (lines.size() > maxCachedLines)
+	{
+		lineIndex.erase(lines.back().first);
+		lines.pop_back();
+	}
+	return lines.front().second;
+}
+
+const char* DocumentMappedFile::GetLineText(unsigned long index, unsigned long& length) const
+{
+	//Reads straight from the view so lexing the whole file does not materialize every line
+	std::lock_guard<std::mutex> lock(indexLock);
+	length = lineLengths[index];
+	return view + lineStarts[index];
+}
+
+void DocumentMappedFile::IndexLines(
+	const char* begin,
+	const char* end,
+	bool trimWhitespace,
+	std::vector<unsigned long>& lineStarts,
+	std::vector<unsigned long>& lineLengths)
+{
+	//Mirrors std::getline: a trailing newline does not start another line
+	for (auto position = begin; position < end; )
+	{
+		auto newLine = FindNewLine(position, end);
+		lineStarts.push_back(position - begin);
+		lineLengths.push_back(trimWhitespace ? TrimmedLength(position, newLine) : UntrimmedLength(position, newLine));
+		position = newLine + 1;
+	}
+}
+
+const char* DocumentMappedFile::FindNewLine(const char* begin, const char* end)
+{
+#ifdef __SSE2__
+	//Compare 16 bytes at a time and use the byte mask of the comparison to locate the first newline
+	const auto newLines = _mm_set1_epi8('\n');
+	while (end - begin >= 16)
+	{
+		auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+		auto mask = _mm_movemask_epi8(_mm_cmpeq_epi8(block, newLines));
+		if (mask != 0)
+			return begin + __builtin_ctz(mask);
+		begin += 16;
+	}
+#endif
+	auto newLine = static_cast<const char*>(std::memchr(begin, '\n', end - begin));
+	return newLine == nullptr ? end : newLine;
+}
+
+unsigned long DocumentMappedFile::TrimmedLength(const char* begin, const char* end)
+{
+	//Same trailing whitespace rules as STRING::rtrim (this also drops the \r of a \r\n pair)
+	while (end > begin && std::isspace(static_cast<unsigned char>(end[-1])))
+		--end;
+	return end - begin;
+}
+
+unsigned long DocumentMappedFile::UntrimmedLength(const char* begin, const char* end)
+{
+	if (end > begin && end[-1] == '\r')
+		--end;
+	return end - begin;
+}
+
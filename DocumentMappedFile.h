@@ -0,0 +1,75 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    DocumentMappedFile.h
+// Description: This file declares the DocumentMappedFile class.  This class
+//              maps a file into memory and indexes the start and (right trimmed)
+//              length of each line without copying any text.  Trimming can be
+//              turned off (only the \r of a \r\n pair is dropped) to read back a
+//              file exactly as the document saved it.  Line strings are
+//              only materialized when they are requested and only the most
+//              recently used ones are kept.  Indexing may be
+//              done a chunk at a time on a worker thread while the lines that
+//              have already been published are read on the UI thread.
+//
+// Created:     2026-10-17 10:02:37
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <list>
+#include <atomic>
+#include <mutex>
+#include <CRL/WinUtility.h>
+
+class DocumentMappedFile
+{
+public:
+	DocumentMappedFile() = default;
+	DocumentMappedFile(const DocumentMappedFile& rhs) = delete;
+	~DocumentMappedFile();
+
+	DocumentMappedFile& operator=(const DocumentMappedFile& rhs) = delete;
+
+	bool Open(const std::string& fileName, unsigned long minimumSize, bool trimWhitespace);
+	void Close();
+
+	bool IndexChunk(unsigned long chunkSize);
+	bool IsIndexed() const;
+
+	unsigned long GetLineCount() const;
+	unsigned long GetLineLength(unsigned long index) const;
+	const std::string& GetLine(unsigned long index) const;
+	const char* GetLineText(unsigned long index, unsigned long& length) const;
+
+	static void IndexLines(
+		const char* begin,
+		const char* end,
+		bool trimWhitespace,
+		std::vector<unsigned long>& lineStarts,
+		std::vector<unsigned long>& lineLengths);
+
+private:
+	typedef std::list<std::pair<unsigned long, std::string>> LineList;
+
+	static const char* FindNewLine(const char* begin, const char* end);
+	static unsigned long TrimmedLength(const char* begin, const char* end);
+	static unsigned long UntrimmedLength(const char* begin, const char* end);
+
+private:
+	friend class DocumentMappedFileTest;
+	WIN::CHandle file;
+	WIN::CHandle mapping;
+	const char* view = nullptr;
+	unsigned long size = 0;
+	unsigned long indexedSize = 0;
+	bool trimWhitespace = true;
+	mutable std::mutex indexLock;
+	std::vector<unsigned long> lineStarts;
+	std::vector<unsigned long> lineLengths;
+	std::atomic<unsigned long> lineCount{0};
+	std::atomic<bool> indexed{false};
+	mutable LineList lines;
+	mutable std::unordered_map<unsigned long, LineList::iterator> lineIndex;
+};
+
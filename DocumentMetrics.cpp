@@ -0,0 +1,42 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    DocumentMetrics.cpp
+// Description: This file implements all DocumentMetrics member functions.
+//
+// Created:     2026-10-17 17:48:26
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#include "pch.h"
+#include "DocumentMetrics.h"
+
+DocumentMetrics::DocumentMetrics(unsigned long lineCount, unsigned long maxWidth)
+	: lineCount(lineCount), maxWidth(maxWidth)
+{
+}
+
+bool DocumentMetrics::operator==(const DocumentMetrics& rhs) const
+{
+	return lineCount == rhs.lineCount && maxWidth == rhs.maxWidth;
+}
+
+bool DocumentMetrics::operator!=(const DocumentMetrics& rhs) const
+{
+	return !(*this == rhs);
+}
+
+unsigned long DocumentMetrics::GetLineCount() const
+{
+	return lineCount;
+}
+
+unsigned long DocumentMetrics::GetMaxWidth() const
+{
+	return maxWidth;
+}
+
+int DocumentMetrics::GetLineNumberDigits() const
+{
+	auto digits = 0;
+	for (auto value = lineCount; value > 0; value /= 10)
+		++digits;
+	return digits;
+}
@@ -0,0 +1,30 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    DocumentMetrics.h
+// Description: This file declares the DocumentMetrics class.  The metrics are
+//              the line count and the width of the widest line, which size the
+//              scroll bars and the line number margin.  The document reports
+//              the metrics before and after an edit only when one of them
+//              changed, which is rare while typing.
+//
+// Created:     2026-10-17 17:48:26
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+class DocumentMetrics
+{
+public:
+	DocumentMetrics() = default;
+	DocumentMetrics(unsigned long lineCount, unsigned long maxWidth);
+
+	bool operator==(const DocumentMetrics& rhs) const;
+	bool operator!=(const DocumentMetrics& rhs) const;
+
+	unsigned long GetLineCount() const;
+	unsigned long GetMaxWidth() const;
+	int GetLineNumberDigits() const;
+
+private:
+	unsigned long lineCount = 0;
+	unsigned long maxWidth = 0;
+};
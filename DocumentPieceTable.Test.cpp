@@ -0,0 +1,141 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    DocumentPieceTable.Test.cpp
+// Description: This file defines all DocumentPieceTable unit tests.
+//
+// Created:     2026-10-17 09:14:06
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#include "DocumentPieceTable.h"
+#include <UnitTest/UnitTest.h>
+#include <random>
+using UnitTest::Assert;
+
+TEST_CLASS(DocumentPieceTableTest)
+{
+public:
+	DocumentPieceTableTest()
+	{
+	}
+
+	TEST_METHOD(LoadReferencesOriginalLines)
+	{
+		DocumentPieceTable table;
+		table.Load({ "one", "two", "three" });
+		Assert::AreEqual(3ul, table.GetLineCount());
+		Assert::AreEqual(1ul, table.GetPieceCount());
+		Assert::AreEqual(std::string("two"), table.GetLine(1));
+		Assert::IsTrue(table.added.empty());
+	}
+
+	TEST_METHOD(ReplaceLineSplitsPiece)
+	{
+		DocumentPieceTable table;
+		table.Load({ "one", "two", "three" });
+		table.ReplaceLine(1, "TWO");
+		Assert::AreEqual(3ul, table.GetLineCount());
+		Assert::AreEqual(3ul, table.GetPieceCount());
+		Assert::AreEqual(std::string("one"), table.GetLine(0));
+		Assert::AreEqual(std::string("TWO"), table.GetLine(1));
+		Assert::AreEqual(std::string("three"), table.GetLine(2));
+		Assert::AreEqual(std::string("two"), table.original[1]);
+	}
+
+	TEST_METHOD(InsertAndEraseLines)
+	{
+		DocumentPieceTable table;
+		table.Load({ "a", "d" });
+		table.InsertLines(1, { "b", "c" });
+		table.InsertLines(4, { "e" });
+		Assert::AreEqual(5ul, table.GetLineCount());
+		for (auto index = 0ul; index < 5; ++index)
+			Assert::AreEqual(std::string(1, static_cast<char>('a' + index)), table.GetLine(index));
+		table.EraseLines(1, 3);
+		Assert::AreEqual(2ul, table.GetLineCount());
+		Assert::AreEqual(std::string("a"), table.GetLine(0));
+		Assert::AreEqual(std::string("e"), table.GetLine(1));
+		table.EraseLines(0, 2);
+		Assert::AreEqual(0ul, table.GetLineCount());
+	}
+
+	TEST_METHOD(RandomEditsMatchVector)
+	{
+		std::vector<std::string> expected;
+		for (auto index = 0; index < 100; ++index)
+			expected.push_back(std::to_string(index));
+		DocumentPieceTable table;
+		table.Load(std::vector<std::string>(expected));
+
+		std::mt19937 random(1234);
+		for (auto iteration = 0; iteration < 2000; ++iteration)
+		{
+			auto index = expected.empty() ? 0ul : random() % expected.size();
+			auto value = "edit" + std::to_string(iteration);
+			switch (random() % 3)
+			{
+			case 0:
+				if (!expected.empty())
+				{
+					expected[index] = value;
+					table.ReplaceLine(index, value);
+				}
+				break;
+			case 1:
+				index = random() % (expected.size() + 1);
+				expected.insert(expected.begin() + index, { value, value + "b" });
+				table.InsertLines(index, { value, value + "b" });
+				break;
+			case 2:
+				if (!expected.empty())
+				{
+					auto count = MinCount(random() % 3, expected.size() - index);
+					expected.erase(expected.begin() + index, expected.begin() + index + count);
+					table.EraseLines(index, count);
+				}
+				break;
+			}
+		}
+
+		Assert::AreEqual(static_cast<unsigned long>(expected.size()), table.GetLineCount());
+		for (auto index = 0ul; index < expected.size(); ++index)
+			Assert::AreEqual(expected[index], table.GetLine(index));
+	}
+
+	TEST_METHOD(SplitPiecesStayBalanced)
+	{
+		//Replacing or erasing every other line (as Tabify does) splits pieces over and over,
+		//a treap of 100000 to 200000 pieces is expected to be around 40 deep.
+		const auto lineCount = 200000ul;
+		DocumentPieceTable replaced;
+		replaced.Load(std::vector<std::string>(lineCount, "line"));
+		for (auto index = 0ul; index < lineCount; index += 2)
+			replaced.ReplaceLine(index, "\tline");
+		Assert::AreEqual(lineCount, replaced.GetPieceCount());
+		Assert::AreEqual(std::string("\tline"), replaced.GetLine(lineCount - 2));
+		Assert::AreEqual(std::string("line"), replaced.GetLine(lineCount - 1));
+		Assert::IsTrue(GetDepth(replaced.root) < 100ul);
+
+		//Erasing leaves only tails of split pieces
+		DocumentPieceTable erased;
+		erased.Load(std::vector<std::string>(lineCount, "line"));
+		for (auto index = 0ul; index < lineCount / 2; ++index)
+			erased.EraseLines(index, 1);
+		Assert::AreEqual(lineCount / 2, erased.GetPieceCount());
+		Assert::IsTrue(GetDepth(erased.root) < 100ul);
+	}
+
+private:
+	static unsigned long MinCount(unsigned long lhs, unsigned long rhs)
+	{
+		return lhs < rhs ? lhs : rhs;
+	}
+
+	static unsigned long GetDepth(const DocumentPieceTable::PiecePtr& piece)
+	{
+		if (!piece)
+			return 0;
+		auto leftDepth = GetDepth(piece->left);
+		auto rightDepth = GetDepth(piece->right);
+		return 1 + (leftDepth > rightDepth ? leftDepth : rightDepth);
+	}
+};
+
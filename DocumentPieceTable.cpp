@@ -0,0 +1,248 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    DocumentPieceTable.cpp
+// Description: This file implements all DocumentPieceTable member functions.
+//
+// Created:     2026-10-17 09:14:06
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#include "pch.h"
+#include "DocumentPieceTable.h"
+#include "DocumentMappedFile.h"
+#include <cassert>
+#include <iterator>
+
+DocumentPieceTable::Piece::Piece(bool added, unsigned long start, unsigned long count, unsigned int priority)
+	: added(added), start(start), count(count), lineCount(count), pieceCount(1), priority(priority)
+{
+}
+
+DocumentPieceTable::DocumentPieceTable()
+{
+}
+
+DocumentPieceTable::~DocumentPieceTable()
+{
+}
+
+void DocumentPieceTable::Load(std::vector<std::string>&& lines)
+{
+	mappedFile.reset();
+	original = std::move(lines);
+	originalCount = 0;
+	added.clear();
+	root.reset();
+	AppendOriginalLines(original.size());
+}
+
+void DocumentPieceTable::Load(std::unique_ptr<DocumentMappedFile>&& file)
+{
+	original.clear();
+	originalCount = 0;
+	added.clear();
+	root.reset();
+	mappedFile = std::move(file);
+	AppendOriginalLines(mappedFile->GetLineCount());
+}
+
+void DocumentPieceTable::AppendOriginalLines(unsigned long count)
+{
+	//Lines that arrive after the initial load (streaming open) are added to the end of the document
+	if (count == 0)
+		return;
+	root = Merge(std::move(root), CreatePiece(false, originalCount, count));
+	originalCount += count;
+}
+
+bool DocumentPieceTable::IsMapped() const
+{
+	return mappedFile != nullptr;
+}
+
+unsigned long DocumentPieceTable::GetLineCount() const
+{
+	return LineCount(root);
+}
+
+const std::string& DocumentPieceTable::GetLine(unsigned long index) const
+{
+	unsigned long offset = 0;
+	auto piece = FindPiece(index, offset);
+	if (piece->added)
+		return added[offset];
+	return mappedFile ? mappedFile->GetLine(offset) : original[offset];
+}
+
+const char* DocumentPieceTable::GetLineText(unsigned long index, unsigned long& length) const
+{
+	unsigned long offset = 0;
+	auto piece = FindPiece(index, offset);
+	if (mappedFile && !piece->added)
+		return mappedFile->GetLineText(offset, length);
+	const auto& line = piece->added ? added[offset] : original[offset];
+	length = line.size();
+	return line.data();
+}
+
+void DocumentPieceTable::ReplaceLine(unsigned long index, const std::string& value)
+{
+	assert(index < GetLineCount());
+
+	//Cut out the single line piece and splice in a new piece referencing the added buffer
+	PiecePtr left, middle, right;
+	Split(std::move(root), index, left, middle);
+	Split(std::move(middle), 1, middle, right);
+	added.push_back(value);
+	middle = CreatePiece(true, added.size() - 1, 1);
+	root = Merge(Merge(std::move(left), std::move(middle)), std::move(right));
+}
+
+void DocumentPieceTable::InsertLines(unsigned long index, std::vector<std::string>&& values)
+{
+	assert(index <= GetLineCount());
+	if (values.empty())
+		return;
+
+	auto start = added.size();
+	added.insert(added.end(), std::make_move_iterator(values.begin()), std::make_move_iterator(values.end()));
+	values.clear();
+
+	PiecePtr left, right;
+	Split(std::move(root), index, left, right);
+	auto piece = CreatePiece(true, start, added.size() - start);
+	root = Merge(Merge(std::move(left), std::move(piece)), std::move(right));
+}
+
+void DocumentPieceTable::EraseLines(unsigned long index, unsigned long count)
+{
+	assert(index + count <= GetLineCount());
+	if (count == 0)
+		return;
+
+	//The erased pieces are simply dropped, the buffers they referenced are append-only
+	PiecePtr left, middle, right;
+	Split(std::move(root), index, left, middle);
+	Split(std::move(middle), count, middle, right);
+	root = Merge(std::move(left), std::move(right));
+}
+
+unsigned long DocumentPieceTable::GetPieceCount() const
+{
+	return PieceCount(root);
+}
+
+const DocumentPieceTable::Piece* DocumentPieceTable::FindPiece(unsigned long index, unsigned long& offset) const
+{
+	assert(index < GetLineCount());
+
+	//Walk down the tree using the subtree line counts to find the piece holding the line
+	auto piece = root.get();
+	for (;;)
+	{
+		auto leftCount = LineCount(piece->left);
+		if (index < leftCount)
+		{
+			piece = piece->left.get();
+		}
+		else if (index < leftCount + piece->count)
+		{
+			offset = piece->start + index - leftCount;
+			return piece;
+		}
+		else
+		{
+			index -= leftCount + piece->count;
+			piece = piece->right.get();
+		}
+	}
+}
+
+DocumentPieceTable::PiecePtr DocumentPieceTable::CreatePiece(bool added, unsigned long start, unsigned long count)
+{
+	return PiecePtr(new Piece(added, start, count, NextPriority()));
+}
+
+unsigned int DocumentPieceTable::NextPriority()
+{
+	//xorshift32 - deterministic and cheap, only needs to be well distributed
+	seed ^= seed << 13;
+	seed ^= seed >> 17;
+	seed ^= seed << 5;
+	return seed;
+}
+
+unsigned long DocumentPieceTable::LineCount(const PiecePtr& piece)
+{
+	return piece ? piece->lineCount : 0;
+}
+
+unsigned long DocumentPieceTable::PieceCount(const PiecePtr& piece)
+{
+	return piece ? piece->pieceCount : 0;
+}
+
+void DocumentPieceTable::Update(Piece* piece)
+{
+	piece->lineCount = LineCount(piece->left) + piece->count + LineCount(piece->right);
+	piece->pieceCount = PieceCount(piece->left) + 1 + PieceCount(piece->right);
+}
+
+void DocumentPieceTable::Split(PiecePtr piece, unsigned long lines, PiecePtr& left, PiecePtr& right)
+{
+	if (!piece)
+	{
+		left.reset();
+		right.reset();
+		return;
+	}
+
+	auto leftCount = LineCount(piece->left);
+	if (lines <= leftCount)
+	{
+		//The split point is entirely within the left subtree
+		PiecePtr leftRight;
+		Split(std::move(piece->left), lines, left, leftRight);
+		piece->left = std::move(leftRight);
+		Update(piece.get());
+		right = std::move(piece);
+	}
+	else if (lines >= leftCount + piece->count)
+	{
+		//The split point is entirely within the right subtree
+		PiecePtr rightLeft;
+		Split(std::move(piece->right), lines - leftCount - piece->count, rightLeft, right);
+		piece->right = std::move(rightLeft);
+		Update(piece.get());
+		left = std::move(piece);
+	}
+	else
+	{
+		//The split point is inside of this piece, so break it in two.  The tail gets its own
+		//priority (shared priorities build long chains of ties) and is merged with the right
+		//subtree, which puts it back in heap order.
+		auto offset = lines - leftCount;
+		auto tail = CreatePiece(piece->added, piece->start + offset, piece->count - offset);
+		piece->count = offset;
+		right = Merge(std::move(tail), std::move(piece->right));
+		Update(piece.get());
+		left = std::move(piece);
+	}
+}
+
+DocumentPieceTable::PiecePtr DocumentPieceTable::Merge(PiecePtr left, PiecePtr right)
+{
+	if (!left)
+		return right;
+	if (!right)
+		return left;
+
+	if (left->priority > right->priority)
+	{
+		left->right = Merge(std::move(left->right), std::move(right));
+		Update(left.get());
+		return left;
+	}
+
+	right->left = Merge(std::move(left), std::move(right->left));
+	Update(right.get());
+	return right;
+}
@@ -0,0 +1,82 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    DocumentPieceTable.h
+// Description: This file declares the DocumentPieceTable class.  This class is
+//              a line based piece table.  The original lines of the file are
+//              never modified, replacement and inserted lines are appended to
+//              the added buffer, and the document is described by a sequence of
+//              pieces (runs of lines from either buffer).  The pieces are held in
+//              a treap ordered by line position so that each piece subtree knows
+//              its line count (the line start index), giving O(log n) lookup and
+//              edits independent of the number of lines in the file.  The
+//              original lines may also come from a memory mapped file, in which
+//              case they are only decoded when first read.
+//
+// Created:     2026-10-17 09:14:06
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "DocumentStorage.h"
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+
+class DocumentPieceTable : public DocumentStorage
+{
+public:
+	DocumentPieceTable();
+	DocumentPieceTable(const DocumentPieceTable& rhs) = delete;
+	~DocumentPieceTable();
+
+	DocumentPieceTable& operator=(const DocumentPieceTable& rhs) = delete;
+
+	void Load(std::vector<std::string>&& lines) override;
+	void Load(std::unique_ptr<DocumentMappedFile>&& file) override;
+	void AppendOriginalLines(unsigned long count) override;
+	bool IsMapped() const override;
+	unsigned long GetLineCount() const override;
+	const std::string& GetLine(unsigned long index) const override;
+	const char* GetLineText(unsigned long index, unsigned long& length) const override;
+	void ReplaceLine(unsigned long index, const std::string& value) override;
+	void InsertLines(unsigned long index, std::vector<std::string>&& values) override;
+	void EraseLines(unsigned long index, unsigned long count) override;
+
+	unsigned long GetPieceCount() const;
+
+private:
+	struct Piece;
+	typedef std::unique_ptr<Piece> PiecePtr;
+
+	struct Piece
+	{
+		Piece(bool added, unsigned long start, unsigned long count, unsigned int priority);
+
+		bool added;
+		unsigned long start;
+		unsigned long count;
+		unsigned long lineCount;
+		unsigned long pieceCount;
+		unsigned int priority;
+		PiecePtr left;
+		PiecePtr right;
+	};
+
+	const Piece* FindPiece(unsigned long index, unsigned long& offset) const;
+	PiecePtr CreatePiece(bool added, unsigned long start, unsigned long count);
+	unsigned int NextPriority();
+	void Split(PiecePtr piece, unsigned long lines, PiecePtr& left, PiecePtr& right);
+
+	static unsigned long LineCount(const PiecePtr& piece);
+	static unsigned long PieceCount(const PiecePtr& piece);
+	static void Update(Piece* piece);
+	static PiecePtr Merge(PiecePtr left, PiecePtr right);
+
+private:
+	friend class DocumentPieceTableTest;
+	std::vector<std::string> original;
+	std::unique_ptr<DocumentMappedFile> mappedFile;
+	unsigned long originalCount = 0;
+	std::deque<std::string> added;
+	PiecePtr root;
+	unsigned int seed = 0x9e3779b9;
+};
@@ -0,0 +1,156 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    DocumentRenderCache.cpp
+// Description: This file implements all DocumentRenderCache member functions.
+//
+// Created:     2026-10-17 17:05:48
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#include "pch.h"
+#include "DocumentRenderCache.h"
+
+//Bitmaps kept beyond the lines of the current frame (enough to scroll back and forth a few pages)
+const auto maxCachedLines = 512ul;
+
+bool DocumentRenderCache::Key::operator==(const Key& rhs) const
+{
+	if (textHash != rhs.textHash ||
+		textLength != rhs.textLength ||
+		selectedColumnStart != rhs.selectedColumnStart ||
+		selectedColumnEnd != rhs.selectedColumnEnd ||
+		isCurrentLine != rhs.isCurrentLine ||
+		isEmptyVerticalSelection != rhs.isEmptyVerticalSelection ||
+		runs.size() != rhs.runs.size() ||
+		matches.size() != rhs.matches.size())
+		return false;
+	for (unsigned long index = 0; index < runs.size(); ++index)
+		if (runs[index].start != rhs.runs[index].start ||
+			runs[index].length != rhs.runs[index].length ||
+			runs[index].token != rhs.runs[index].token)
+			return false;
+
+	//The line number of a match does not matter, the same text may be shown on another row
+	for (unsigned long index = 0; index < matches.size(); ++index)
+		if (matches[index].firstColumn != rhs.matches[index].firstColumn ||
+			matches[index].lastColumn != rhs.matches[index].lastColumn)
+			return false;
+	return true;
+}
+
+unsigned long long DocumentRenderCache::Key::GetHash() const
+{
+	auto hash = textHash;
+	hash = hash * 31 + selectedColumnStart;
+	hash = hash * 31 + selectedColumnEnd;
+	hash = hash * 31 + (isCurrentLine ? 1 : 0);
+	hash = hash * 31 + (isEmptyVerticalSelection ? 1 : 0);
+	for (const auto& run: runs)
+		hash = hash * 31 + run.length * 8 + static_cast<unsigned long>(run.token);
+	for (const auto& match: matches)
+		hash = hash * 31 + match.firstColumn;
+	return hash;
+}
+
+DocumentRenderCache::~DocumentRenderCache()
+{
+	Clear();
+}
+
+void DocumentRenderCache::BeginFrame(HDC dc, unsigned long firstColumn, unsigned long lastColumn, int width, int height)
+{
+	//Every bitmap depends on the horizontal scroll position and the size of a row
+	if (firstColumn != this->firstColumn || lastColumn != this->lastColumn || width != this->width || height != this->height)
+	{
+		Clear();
+		this->firstColumn = firstColumn;
+		this->lastColumn = lastColumn;
+		this->width = width;
+		this->height = height;
+	}
+
+	++frame;
+	drawCount = 0;
+	renderCount = 0;
+	cacheDc = ::CreateCompatibleDC(dc);
+	oldFont = ::SelectObject(cacheDc, ::GetCurrentObject(dc, OBJ_FONT));
+	oldBitmap = nullptr;
+}
+
+bool DocumentRenderCache::Draw(HDC dc, const Key& key, int left, int top)
+{
+	auto iter = Find(key, key.GetHash());
+	if (iter == entries.end())
+		return false;
+
+	iter->second.frame = frame;
+	auto previous = ::SelectObject(cacheDc, iter->second.bitmap);
+	if (oldBitmap == nullptr)
+		oldBitmap = previous;
+	::BitBlt(dc, left, top, width, height, cacheDc, 0, 0, SRCCOPY);
+	++drawCount;
+	return true;
+}
+
+void DocumentRenderCache::Render(HDC dc, Key&& key, int left, int top, const std::function<void(HDC, const RECT&)>& draw)
+{
+	auto bitmap = ::CreateCompatibleBitmap(dc, width, height);
+	auto previous = ::SelectObject(cacheDc, bitmap);
+	if (oldBitmap == nullptr)
+		oldBitmap = previous;
+	RECT rect = { 0, 0, width, height };
+	draw(cacheDc, rect);
+	::BitBlt(dc, left, top, width, height, cacheDc, 0, 0, SRCCOPY);
+
+	auto hash = key.GetHash();
+	entries.insert({ hash, Entry{ std::move(key), bitmap, frame } });
+	++renderCount;
+}
+
+void DocumentRenderCache::EndFrame()
+{
+	if (oldBitmap != nullptr)
+		::SelectObject(cacheDc, oldBitmap);
+	::SelectObject(cacheDc, oldFont);
+	::DeleteDC(cacheDc);
+	cacheDc = nullptr;
+
+	//Drop the lines that were not part of this frame once there are too many
+	if (entries.size() > maxCachedLines)
+	{
+		for (auto iter = entries.begin(); iter != entries.end(); )
+		{
+			if (iter->second.frame != frame)
+			{
+				::DeleteObject(iter->second.bitmap);
+				iter = entries.erase(iter);
+			}
+			else
+				++iter;
+		}
+	}
+}
+
+void DocumentRenderCache::Clear()
+{
+	for (auto& entry: entries)
+		::DeleteObject(entry.second.bitmap);
+	entries.clear();
+}
+
+unsigned long DocumentRenderCache::GetDrawCount() const
+{
+	return drawCount;
+}
+
+unsigned long DocumentRenderCache::GetRenderCount() const
+{
+	return renderCount;
+}
+
+std::unordered_multimap<unsigned long long, DocumentRenderCache::Entry>::iterator DocumentRenderCache::Find(const Key& key, unsigned long long hash)
+{
+	auto range = entries.equal_range(hash);
+	for (auto iter = range.first; iter != range.second; ++iter)
+		if (iter->second.key == key)
+			return iter;
+	return entries.end();
+}
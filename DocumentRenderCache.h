@@ -0,0 +1,76 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    DocumentRenderCache.h
+// Description: This file declares the DocumentRenderCache class.  This class
+//              keeps the text area of recently painted lines as bitmaps keyed
+//              by everything that affects how the line looks (a hash of its
+//              text, its token runs, the selected columns and the search
+//              matches).  Painting a line that did not change, including one
+//              that only moved because the view scrolled, is a single blit.
+//
+// Created:     2026-10-17 17:05:48
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include "DocumentLexer.h"
+#include "DocumentSearch.h"
+
+class DocumentRenderCache
+{
+public:
+	struct Key
+	{
+		unsigned long long textHash = 0;
+		unsigned long textLength = 0;
+		std::vector<DocumentLexer::Run> runs;
+		unsigned long selectedColumnStart = 0;
+		unsigned long selectedColumnEnd = 0;
+		std::vector<DocumentSearch::Match> matches;
+		bool isCurrentLine = false;
+		bool isEmptyVerticalSelection = false;
+
+		bool operator==(const Key& rhs) const;
+		unsigned long long GetHash() const;
+	};
+
+	DocumentRenderCache() = default;
+	DocumentRenderCache(const DocumentRenderCache& rhs) = delete;
+	~DocumentRenderCache();
+
+	DocumentRenderCache& operator=(const DocumentRenderCache& rhs) = delete;
+
+	void BeginFrame(HDC dc, unsigned long firstColumn, unsigned long lastColumn, int width, int height);
+	bool Draw(HDC dc, const Key& key, int left, int top);
+	void Render(HDC dc, Key&& key, int left, int top, const std::function<void(HDC, const RECT&)>& draw);
+	void EndFrame();
+	void Clear();
+
+	unsigned long GetDrawCount() const;
+	unsigned long GetRenderCount() const;
+
+private:
+	struct Entry
+	{
+		Key key;
+		HBITMAP bitmap;
+		unsigned long frame;
+	};
+
+	std::unordered_multimap<unsigned long long, Entry>::iterator Find(const Key& key, unsigned long long hash);
+
+private:
+	std::unordered_multimap<unsigned long long, Entry> entries;
+	HDC cacheDc = nullptr;
+	HGDIOBJ oldBitmap = nullptr;
+	HGDIOBJ oldFont = nullptr;
+	unsigned long firstColumn = 0;
+	unsigned long lastColumn = 0;
+	int width = 0;
+	int height = 0;
+	unsigned long frame = 0;
+	unsigned long drawCount = 0;
+	unsigned long renderCount = 0;
+};
@@ -0,0 +1,89 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    DocumentSearch.Test.cpp
+// Description: This file defines all DocumentSearch unit tests.
+//
+// Created:     2026-10-17 14:02:51
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#include "DocumentSearch.h"
+#include <UnitTest/UnitTest.h>
+using UnitTest::Assert;
+
+TEST_CLASS(DocumentSearchTest)
+{
+public:
+	DocumentSearchTest()
+	{
+	}
+
+	TEST_METHOD(FindsEveryMatchInLine)
+	{
+		DocumentSearch search("line", false, false, false);
+		std::vector<DocumentSearch::Match> matches;
+		FindInLine(search, 3, "GetLine(line) + LINE", matches);
+		Assert::AreEqual(3ul, static_cast<unsigned long>(matches.size()));
+		Assert::AreEqual(3ul, matches[0].line);
+		Assert::AreEqual(3ul, matches[0].index);
+		Assert::AreEqual(8ul, matches[1].index);
+		Assert::AreEqual(16ul, matches[2].index);
+		Assert::AreEqual(4ul, matches[2].length);
+	}
+
+	TEST_METHOD(MatchCaseAndWholeWord)
+	{
+		DocumentSearch search("line", true, true, false);
+		std::vector<DocumentSearch::Match> matches;
+		FindInLine(search, 0, "GetLine(line) + LINE + line_", matches);
+		Assert::AreEqual(1ul, static_cast<unsigned long>(matches.size()));
+		Assert::AreEqual(8ul, matches[0].index);
+	}
+
+	TEST_METHOD(RegexMatches)
+	{
+		DocumentSearch search("[a-z]+\\(", false, false, true);
+		std::vector<DocumentSearch::Match> matches;
+		FindInLine(search, 0, "Max(Min(a, b), c)", matches);
+		Assert::AreEqual(2ul, static_cast<unsigned long>(matches.size()));
+		Assert::AreEqual(4ul, matches[0].length);
+		Assert::AreEqual(4ul, matches[1].index);
+	}
+
+	TEST_METHOD(RegexContinuesWithinLine)
+	{
+		//Word boundaries and empty matches after the first match use the preceding text
+		DocumentSearch search("\\bx\\b|y*", true, false, true);
+		std::vector<DocumentSearch::Match> matches;
+		FindInLine(search, 0, "ax x yy", matches);
+		Assert::AreEqual(2ul, static_cast<unsigned long>(matches.size()));
+		Assert::AreEqual(3ul, matches[0].index);
+		Assert::AreEqual(5ul, matches[1].index);
+		Assert::AreEqual(2ul, matches[1].length);
+	}
+
+	TEST_METHOD(IncompleteRegexIsInvalid)
+	{
+		DocumentSearch search("Get(", false, false, true);
+		Assert::IsFalse(search.IsValid());
+		std::vector<DocumentSearch::Match> matches;
+		FindInLine(search, 0, "Get(", matches);
+		Assert::IsTrue(matches.empty());
+	}
+
+	TEST_METHOD(SearchStopsAtLength)
+	{
+		//Lines of a mapped file are not terminated, the text after the length belongs to the next line
+		DocumentSearch search("line", false, false, false);
+		std::vector<DocumentSearch::Match> matches;
+		std::string text = "a line\nline";
+		search.FindInLine(0, text.data(), 6, matches);
+		Assert::AreEqual(1ul, static_cast<unsigned long>(matches.size()));
+		Assert::AreEqual(2ul, matches[0].index);
+	}
+
+private:
+	static void FindInLine(const DocumentSearch& search, unsigned long line, const std::string& text, std::vector<DocumentSearch::Match>& matches)
+	{
+		search.FindInLine(line, text.data(), text.size(), matches);
+	}
+};
+
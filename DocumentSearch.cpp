@@ -0,0 +1,123 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    DocumentSearch.cpp
+// Description: This file implements all DocumentSearch member functions.
+//
+// Created:     2026-10-17 14:02:51
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#include "pch.h"
+#include "DocumentSearch.h"
+
+DocumentSearch::DocumentSearch(const std::string& pattern, bool matchCase, bool wholeWord, bool isRegex)
+	: pattern(pattern), matchCase(matchCase), wholeWord(wholeWord), isRegex(isRegex), textSearch(pattern)
+{
+	if (!isRegex || pattern.empty())
+		return;
+
+	//The pattern is being typed, so an incomplete expression just matches nothing
+	try
+	{
+		auto flags = std::regex::ECMAScript | std::regex::optimize;
+		if (!matchCase)
+			flags |= std::regex::icase;
+		expression.assign(pattern, flags);
+	}
+	catch (const std::regex_error&)
+	{
+		isValid = false;
+	}
+}
+
+const std::string& DocumentSearch::GetPattern() const
+{
+	return pattern;
+}
+
+bool DocumentSearch::IsMatchCase() const
+{
+	return matchCase;
+}
+
+bool DocumentSearch::IsWholeWord() const
+{
+	return wholeWord;
+}
+
+bool DocumentSearch::IsRegex() const
+{
+	return isRegex;
+}
+
+bool DocumentSearch::IsEmpty() const
+{
+	return pattern.empty();
+}
+
+bool DocumentSearch::IsValid() const
+{
+	return isValid;
+}
+
+void DocumentSearch::FindInLine(unsigned long line, const char* text, unsigned long length, std::vector<Match>& matches) const
+{
+	if (IsEmpty() || !IsValid())
+		return;
+
+	//The text is not terminated, it may point into a mapped file
+	auto begin = text;
+	auto end = begin + length;
+	for (auto position = begin; position < end; )
+	{
+		const char* matchBegin = nullptr;
+		const char* matchEnd = nullptr;
+		if (!FindNext(begin, end, position, matchBegin, matchEnd))
+			break;
+
+		//Empty (regex) matches and matches inside of a word are skipped
+		if (matchBegin == matchEnd ||
+			(wholeWord && (!IsWordBoundary(begin, end, matchBegin) || !IsWordBoundary(begin, end, matchEnd))))
+		{
+			position = matchBegin + 1;
+			continue;
+		}
+
+		matches.push_back({ line, static_cast<unsigned long>(matchBegin - begin), static_cast<unsigned long>(matchEnd - matchBegin), 0, 0 });
+		position = matchEnd;
+	}
+}
+
+bool DocumentSearch::FindNext(
+	const char* begin,
+	const char* end,
+	const char* position,
+	const char*& matchBegin,
+	const char*& matchEnd) const
+{
+	if (isRegex)
+	{
+		//Let anchors and \b see the text before the position when continuing within a line
+		std::cmatch match;
+		auto flags = position == begin ? std::regex_constants::match_default : std::regex_constants::match_prev_avail;
+		if (!std::regex_search(position, end, match, expression, flags))
+			return false;
+		matchBegin = match[0].first;
+		matchEnd = match[0].second;
+		return true;
+	}
+
+	matchBegin = matchCase ?
+		std::search(position, end, pattern.begin(), pattern.end()) :
+		textSearch.Find(position, end);
+	if (matchBegin == end)
+		return false;
+	matchEnd = matchBegin + pattern.size();
+	return true;
+}
+
+bool DocumentSearch::IsWordBoundary(const char* begin, const char* end, const char* position)
+{
+	//A match edge is a boundary unless it is inside of an identifier or number
+	return position == begin || position == end ||
+		!STRING::isidnum(position[-1]) || !STRING::isidnum(position[0]);
+}
+
@@ -0,0 +1,60 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    DocumentSearch.h
+// Description: This file declares the DocumentSearch class.  This class is a
+//              compiled find query (plain text or ECMAScript regular expression
+//              with case and whole word options) that reports every match in a
+//              line.  The query is compiled once and lines are searched in place.
+//
+// Created:     2026-10-17 14:02:51
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <string>
+#include <vector>
+#include <regex>
+#include "TextSearch.h"
+
+class DocumentSearch
+{
+public:
+	struct Match
+	{
+		unsigned long line;
+		unsigned long index;
+		unsigned long length;
+		unsigned long firstColumn;
+		unsigned long lastColumn;
+	};
+
+	DocumentSearch() = default;
+	DocumentSearch(const std::string& pattern, bool matchCase, bool wholeWord, bool isRegex);
+
+	const std::string& GetPattern() const;
+	bool IsMatchCase() const;
+	bool IsWholeWord() const;
+	bool IsRegex() const;
+	bool IsEmpty() const;
+	bool IsValid() const;
+	void FindInLine(unsigned long line, const char* text, unsigned long length, std::vector<Match>& matches) const;
+
+private:
+	bool FindNext(
+		const char* begin,
+		const char* end,
+		const char* position,
+		const char*& matchBegin,
+		const char*& matchEnd) const;
+
+	static bool IsWordBoundary(const char* begin, const char* end, const char* position);
+
+private:
+	friend class DocumentSearchTest;
+	std::string pattern;
+	bool matchCase = false;
+	bool wholeWord = false;
+	bool isRegex = false;
+	bool isValid = true;
+	TextSearch textSearch{ std::string() };
+	std::regex expression;
+};
+
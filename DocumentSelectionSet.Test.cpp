@@ -0,0 +1,64 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    DocumentSelectionSet.Test.cpp
+// Description: This file defines all DocumentSelectionSet unit tests.
+//
+// Created:     2026-10-17 18:05:51
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#include "DocumentSelectionSet.h"
+#include <UnitTest/UnitTest.h>
+using UnitTest::Assert;
+
+TEST_CLASS(DocumentSelectionSetTest)
+{
+public:
+	DocumentSelectionSetTest()
+	{
+	}
+
+	TEST_METHOD(SelectionsAreSorted)
+	{
+		DocumentSelectionSet selections;
+		Assert::IsTrue(selections.IsEmpty());
+		selections.Add(Select(7, 2, 7, 4));
+		selections.Add(Select(1, 0, 1, 0));
+		selections.Add(Select(7, 0, 7, 1));
+		Assert::AreEqual(3ul, selections.GetCount());
+		Assert::AreEqual(1ul, selections.Get(0).GetStartLine());
+		Assert::AreEqual(0ul, selections.Get(1).GetStartColumn());
+		Assert::AreEqual(2ul, selections.Get(2).GetStartColumn());
+		Assert::AreEqual(1ul, selections.FindFirstOnLine(2));
+		Assert::AreEqual(2ul, selections.Find({ 7, 3 }));
+		Assert::AreEqual(3ul, selections.Find({ 7, 5 }));
+	}
+
+	TEST_METHOD(OverlappingSelectionsAreMerged)
+	{
+		DocumentSelectionSet selections;
+		selections.Add(Select(2, 5, 2, 5));
+		selections.Add(Select(3, 0, 3, 4));
+		selections.Add(Select(9, 0, 9, 0));
+		selections.Add(Select(3, 6, 2, 5));
+		Assert::AreEqual(2ul, selections.GetCount());
+
+		//The merged selection keeps the direction of the selection that was added
+		const auto& merged = selections.Get(0);
+		Assert::AreEqual(3ul, merged.GetStartLine());
+		Assert::AreEqual(6ul, merged.GetStartColumn());
+		Assert::AreEqual(2ul, merged.GetEndLine());
+		Assert::AreEqual(5ul, merged.GetEndColumn());
+		Assert::IsFalse(merged.IsVertical());
+
+		selections.Add(Select(9, 0, 9, 0));
+		Assert::AreEqual(2ul, selections.GetCount());
+	}
+
+private:
+	static DocumentSelection Select(unsigned long startLine, unsigned long startColumn, unsigned long endLine, unsigned long endColumn)
+	{
+		DocumentSelection selection;
+		selection.SetStart({ startLine, startColumn });
+		selection.SetEnd({ endLine, endColumn });
+		return selection;
+	}
+};
@@ -0,0 +1,91 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    DocumentSelectionSet.cpp
+// Description: This file implements all DocumentSelectionSet member functions.
+//
+// Created:     2026-10-17 18:05:51
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#include "pch.h"
+#include "DocumentSelectionSet.h"
+
+void DocumentSelectionSet::Clear()
+{
+	selections.clear();
+}
+
+bool DocumentSelectionSet::IsEmpty() const
+{
+	return selections.empty();
+}
+
+unsigned long DocumentSelectionSet::GetCount() const
+{
+	return selections.size();
+}
+
+const DocumentSelection& DocumentSelectionSet::Get(unsigned long index) const
+{
+	return selections[index];
+}
+
+const std::vector<DocumentSelection>& DocumentSelectionSet::GetSelections() const
+{
+	return selections;
+}
+
+void DocumentSelectionSet::Add(const DocumentSelection& value)
+{
+	//Vertical selections cannot be combined with others, so only their corners are kept
+	auto first = GetFirst(value);
+	auto last = GetLast(value);
+	auto inverted = value.GetEnd() < value.GetStart();
+
+	//Absorb every selection that overlaps or touches the new one (they are consecutive)
+	auto iter = std::lower_bound(selections.begin(), selections.end(), first,
+		[](const DocumentSelection& selection, const DocumentPosition& position)
+		{
+			return GetLast(selection) < position;
+		});
+	auto end = iter;
+	for (; end != selections.end() && !(last < GetFirst(*end)); ++end)
+	{
+		first = std::min(first, GetFirst(*end));
+		last = std::max(last, GetLast(*end));
+	}
+	iter = selections.erase(iter, end);
+
+	DocumentSelection selection;
+	selection.SetStart(inverted ? last : first);
+	selection.SetEnd(inverted ? first : last);
+	selections.insert(iter, selection);
+}
+
+unsigned long DocumentSelectionSet::Find(const DocumentPosition& position) const
+{
+	auto index = FindFirstOnLine(position.GetLine());
+	for (; index < selections.size() && !(position < GetFirst(selections[index])); ++index)
+		if (!(GetLast(selections[index]) < position))
+			return index;
+	return selections.size();
+}
+
+unsigned long DocumentSelectionSet::FindFirstOnLine(unsigned long line) const
+{
+	//The selections do not overlap, so their last positions are sorted as well
+	auto iter = std::lower_bound(selections.begin(), selections.end(), line,
+		[](const DocumentSelection& selection, unsigned long line)
+		{
+			return GetLast(selection).GetLine() < line;
+		});
+	return iter - selections.begin();
+}
+
+DocumentPosition DocumentSelectionSet::GetFirst(const DocumentSelection& value)
+{
+	return value.GetEnd() < value.GetStart() ? value.GetEnd() : value.GetStart();
+}
+
+DocumentPosition DocumentSelectionSet::GetLast(const DocumentSelection& value)
+{
+	return value.GetEnd() < value.GetStart() ? value.GetStart() : value.GetEnd();
+}
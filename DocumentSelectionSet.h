@@ -0,0 +1,34 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    DocumentSelectionSet.h
+// Description: This file declares the DocumentSelectionSet class.  The set
+//              holds several selections (or carets) of a document sorted from
+//              the top of the document down.  Selections that overlap or touch
+//              are merged into one, so no text is ever selected twice and an
+//              edit can be applied to each selection in turn.
+//
+// Created:     2026-10-17 18:05:51
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "DocumentSelection.h"
+#include <vector>
+
+class DocumentSelectionSet
+{
+public:
+	void Clear();
+	bool IsEmpty() const;
+	unsigned long GetCount() const;
+	const DocumentSelection& Get(unsigned long index) const;
+	const std::vector<DocumentSelection>& GetSelections() const;
+
+	void Add(const DocumentSelection& value);
+	unsigned long Find(const DocumentPosition& position) const;
+	unsigned long FindFirstOnLine(unsigned long line) const;
+
+	static DocumentPosition GetFirst(const DocumentSelection& value);
+	static DocumentPosition GetLast(const DocumentSelection& value);
+
+private:
+	std::vector<DocumentSelection> selections;
+};
@@ -0,0 +1,38 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    DocumentStorage.h
+// Description: This file declares the DocumentStorage interface.  This interface
+//              defines the line based text storage backend used by a document.
+//              Line references returned from GetLine remain valid until the
+//              storage is loaded again (lines are never modified in place),
+//              except for the lines of a memory mapped file which are decoded
+//              into a bounded cache and should be copied if they are kept
+//              while other lines are read.  GetLineText reads the same text
+//              without materializing a string and stays valid until the
+//              storage is next changed.
+//
+// Created:     2026-10-17 09:12:41
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <string>
+#include <vector>
+#include <memory>
+
+class DocumentMappedFile;
+
+class DocumentStorage
+{
+public:
+	virtual ~DocumentStorage() = default;
+
+	virtual void Load(std::vector<std::string>&& lines) = 0;
+	virtual void Load(std::unique_ptr<DocumentMappedFile>&& file) = 0;
+	virtual void AppendOriginalLines(unsigned long count) = 0;
+	virtual bool IsMapped() const = 0;
+	virtual unsigned long GetLineCount() const = 0;
+	virtual const std::string& GetLine(unsigned long index) const = 0;
+	virtual const char* GetLineText(unsigned long index, unsigned long& length) const = 0;
+	virtual void ReplaceLine(unsigned long index, const std::string& value) = 0;
+	virtual void InsertLines(unsigned long index, std::vector<std::string>&& values) = 0;
+	virtual void EraseLines(unsigned long index, unsigned long count) = 0;
+};
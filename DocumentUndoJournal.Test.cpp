@@ -0,0 +1,127 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    DocumentUndoJournal.Test.cpp
+// Description: This file defines all DocumentUndoJournal unit tests.
+//
+// Created:     2026-10-17 11:20:52
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#include "DocumentUndoJournal.h"
+#include <UnitTest/UnitTest.h>
+using UnitTest::Assert;
+
+TEST_CLASS(DocumentUndoJournalTest)
+{
+public:
+	DocumentUndoJournalTest()
+	{
+	}
+
+	TEST_METHOD(TypingIsCoalesced)
+	{
+		DocumentUndoJournal journal;
+		for (auto column = 0ul; column < 10; ++column)
+			journal.Record(CreateTyping(column));
+		journal.EndCoalescing();
+		Assert::AreEqual(1ul, journal.undoCount);
+		Assert::IsTrue(journal.CanUndo());
+		journal.Undo();
+		Assert::IsFalse(journal.CanUndo());
+		Assert::IsTrue(journal.CanRedo());
+	}
+
+	TEST_METHOD(RecordDiscardsRedo)
+	{
+		DocumentUndoJournal journal;
+		journal.Record(CreateTyping(0));
+		journal.Record(CreateTyping(5));
+		journal.Undo();
+		Assert::IsTrue(journal.CanRedo());
+		journal.Record(CreateTyping(7));
+		Assert::IsFalse(journal.CanRedo());
+		journal.Undo();
+		journal.Undo();
+		Assert::IsFalse(journal.CanUndo());
+	}
+
+	TEST_METHOD(BudgetDropsOldestHistory)
+	{
+		DocumentUndoJournal journal;
+		journal.SetBudget(1024);
+		for (auto index = 0ul; index < 1000; ++index)
+			journal.Record(CreateTyping(index * 2));
+		journal.EndCoalescing();
+		Assert::IsTrue(journal.GetSize() <= 1024);
+		Assert::IsTrue(journal.undoCount > 1);
+		Assert::IsTrue(journal.arena.size() <= 2048);
+		while (journal.CanUndo())
+			journal.Undo();
+		while (journal.CanRedo())
+			journal.Redo();
+	}
+
+	TEST_METHOD(JoinedActionsStayTogether)
+	{
+		//Typing at three carets records one action per caret, the last one carries the carets
+		DocumentUndoJournal journal;
+		journal.Record(CreateTyping(20));
+		journal.EndCoalescing();
+		for (auto index = 0ul; index < 3; ++index)
+		{
+			auto action = CreateTyping(10 - index * 4);
+			action.SetJoined(index > 0);
+			if (index == 2)
+				action.SetSelections({ CreateCaret(2), CreateCaret(6), CreateCaret(10) }, { CreateCaret(3), CreateCaret(8), CreateCaret(13) });
+			journal.Record(action);
+		}
+		Assert::AreEqual(3ul, journal.undoCount);
+		Assert::IsTrue(journal.hasPending);
+
+		auto last = journal.Undo();
+		Assert::IsTrue(last.IsJoined());
+		Assert::AreEqual(3ul, static_cast<unsigned long>(last.GetOriginalSelections().size()));
+		Assert::AreEqual(13ul, last.GetFinalSelections().back().GetEndColumn());
+		Assert::IsTrue(journal.Undo().IsJoined());
+		Assert::IsFalse(journal.Undo().IsJoined());
+		Assert::IsFalse(journal.Undo().IsJoined());
+
+		journal.Redo();
+		Assert::IsFalse(journal.IsRedoJoined());
+		journal.Redo();
+		Assert::IsTrue(journal.IsRedoJoined());
+		journal.Redo();
+		Assert::IsTrue(journal.IsRedoJoined());
+		journal.Redo();
+		Assert::IsFalse(journal.CanRedo());
+		Assert::IsFalse(journal.IsRedoJoined());
+	}
+
+private:
+	static DocumentSelection CreateCaret(unsigned long column)
+	{
+		DocumentSelection caret;
+		caret.SetStart(DocumentPosition(0, column));
+		caret.SetEnd(DocumentPosition(0, column));
+		return caret;
+	}
+
+	static DocumentAction CreateTyping(unsigned long column)
+	{
+		DocumentSelection before;
+		before.SetStart(DocumentPosition(0, column));
+		before.SetEnd(DocumentPosition(0, column));
+		DocumentSelection after;
+		after.SetStart(DocumentPosition(0, column + 1));
+		after.SetEnd(DocumentPosition(0, column + 1));
+
+		DocumentAction action;
+		action.SetOriginalSelection(before);
+		action.SetSelectionBeforeDelete(before);
+		action.SetTextDeleted("");
+		action.SetSelectionBeforeInsert(before);
+		action.SetTextInserted("x");
+		action.SetSelectionAfterInsert(after);
+		action.SetFinalSelection(after);
+		return action;
+	}
+};
+
@@ -0,0 +1,134 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    DocumentUndoJournal.cpp
+// Description: This file implements all DocumentUndoJournal member functions.
+//
+// Created:     2026-10-17 11:20:52
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#include "pch.h"
+#include "DocumentUndoJournal.h"
+#include <cassert>
+
+void DocumentUndoJournal::SetBudget(unsigned long value)
+{
+	budget = value;
+	Trim();
+}
+
+void DocumentUndoJournal::Clear()
+{
+	arena.clear();
+	entries.clear();
+	undoCount = 0;
+	deadSize = 0;
+	hasPending = false;
+}
+
+void DocumentUndoJournal::ClearUndo()
+{
+	//Redo history (if any) is kept, only the actions before the current point are dropped
+	Flush();
+	DropFront(undoCount);
+}
+
+void DocumentUndoJournal::Record(const DocumentAction& action)
+{
+	//A new action invalidates anything that was undone
+	if (undoCount < entries.size())
+	{
+		arena.resize(entries[undoCount]);
+		entries.resize(undoCount);
+	}
+
+	//The newest action stays unserialized so that typing can be merged into it
+	if (hasPending && pending.Coalesce(action))
+		return;
+	Flush();
+	pending = action;
+	hasPending = true;
+}
+
+void DocumentUndoJournal::EndCoalescing()
+{
+	Flush();
+}
+
+bool DocumentUndoJournal::CanUndo() const
+{
+	return hasPending || undoCount > 0;
+}
+
+bool DocumentUndoJournal::CanRedo() const
+{
+	return !hasPending && undoCount < entries.size();
+}
+
+bool DocumentUndoJournal::IsRedoJoined() const
+{
+	//The next action to redo belongs to the same batch as the action just redone
+	return CanRedo() && ReadEntry(undoCount).IsJoined();
+}
+
+DocumentAction DocumentUndoJournal::Undo()
+{
+	Flush();
+	assert(undoCount > 0);
+	return ReadEntry(--undoCount);
+}
+
+DocumentAction DocumentUndoJournal::Redo()
+{
+	assert(CanRedo());
+	return ReadEntry(undoCount++);
+}
+
+unsigned long DocumentUndoJournal::GetSize() const
+{
+	return arena.size() - deadSize;
+}
+
+void DocumentUndoJournal::Flush()
+{
+	if (!hasPending)
+		return;
+	entries.push_back(arena.size());
+	pending.Write(arena);
+	++undoCount;
+	hasPending = false;
+	Trim();
+}
+
+void DocumentUndoJournal::Trim()
+{
+	//Drop the oldest undo history first, but always keep the most recent action
+	auto count = 0ul;
+	while (count + 1 < undoCount && arena.size() - entries[count] > budget)
+		++count;
+	DropFront(count);
+}
+
+void DocumentUndoJournal::DropFront(unsigned long count)
+{
+	if (count == 0)
+		return;
+
+	//Dropped entries are only marked dead, the arena is compacted once they are the majority of it
+	deadSize = count < entries.size() ? entries[count] : arena.size();
+	entries.erase(entries.begin(), entries.begin() + count);
+	undoCount -= count;
+	if (deadSize > arena.size() / 2)
+	{
+		arena.erase(arena.begin(), arena.begin() + deadSize);
+		for (auto& entry: entries)
+			entry -= deadSize;
+		deadSize = 0;
+	}
+}
+
+DocumentAction DocumentUndoJournal::ReadEntry(unsigned long index) const
+{
+	DocumentAction action;
+	action.Read(arena.data() + entries[index]);
+	return action;
+}
+
@@ -0,0 +1,56 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    DocumentUndoJournal.h
+// Description: This file declares the DocumentUndoJournal class.  This class
+//              holds the undo and redo history of a document as serialized
+//              actions appended to a single arena.  Consecutive typing and
+//              backspacing is merged into one action and the oldest history
+//              is dropped once the journal grows beyond its byte budget.
+//
+// Created:     2026-10-17 11:20:52
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "DocumentAction.h"
+#include <vector>
+#include <deque>
+
+class DocumentUndoJournal
+{
+public:
+	DocumentUndoJournal() = default;
+	DocumentUndoJournal(const DocumentUndoJournal& rhs) = delete;
+	~DocumentUndoJournal() = default;
+
+	DocumentUndoJournal& operator=(const DocumentUndoJournal& rhs) = delete;
+
+	void SetBudget(unsigned long value);
+	void Clear();
+	void ClearUndo();
+	void Record(const DocumentAction& action);
+	void EndCoalescing();
+
+	bool CanUndo() const;
+	bool CanRedo() const;
+	bool IsRedoJoined() const;
+	DocumentAction Undo();
+	DocumentAction Redo();
+
+	unsigned long GetSize() const;
+
+private:
+	void Flush();
+	void Trim();
+	void DropFront(unsigned long count);
+	DocumentAction ReadEntry(unsigned long index) const;
+
+private:
+	friend class DocumentUndoJournalTest;
+	std::vector<char> arena;
+	std::deque<unsigned long> entries;
+	unsigned long undoCount = 0;
+	unsigned long deadSize = 0;
+	DocumentAction pending;
+	bool hasPending = false;
+	unsigned long budget = 16ul * 1024ul * 1024ul;
+};
+
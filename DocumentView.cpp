@@ -11,10 +11,19 @@
 #include "pch.h"
 #include "DocumentView.h"
 #include "DocumentColor.h"
+#include "Hash.h"
+#include "Trace.h"
+#include "Settings.h"
 #include "resource.h"
+#include <algorithm>
 #include <cstring>
+#include <cstdio>
+#include <chrono>
 
 const int bookmarkWidth = 20;
+const UINT_PTR openTimer = 1;
+const UINT_PTR findTimer = 2;
+const UINT_PTR lexTimer = 3;
 
 DocumentView::DocumentView()
 {
@@ -34,6 +43,10 @@ bool DocumentView::OnCreate(CREATESTRUCT* cs)
 	currentLine.Create(DocumentColor::currentLineBackground);
 	margin.Create(DocumentColor::marginBackground);
 	bookmarkBrush.Create(DocumentColor::marginBookmark);
+	caretBrush.Create(DocumentColor::text);
+
+	Settings settings;
+	showFrameTime = settings.GetShowFrameTime();
 
 	auto dc = ::GetDC(GetHWND());
 	font.Create("Courier New", WIN::CFont::CalcHeight(dc, 10));
@@ -70,6 +83,7 @@ void DocumentView::OnDestroy()
 
 void DocumentView::OnChar(char c, unsigned long flags)
 {
+	Trace::Span trace("edit");
 	if (std::isprint(c))
 		document->InsertText(std::string(1, c));
 	else
@@ -92,6 +106,7 @@ void DocumentView::OnChar(char c, unsigned long flags)
 
 void DocumentView::OnKeyDown(unsigned long key, unsigned long flags)
 {
+	Trace::Span trace("edit");
 	auto shift = (::GetKeyState(VK_SHIFT) < 0);
 	auto control = (::GetKeyState(VK_CONTROL) < 0);
 	auto alt = (::GetKeyState(VK_MENU) < 0);
@@ -156,6 +171,8 @@ void DocumentView::OnKeyDown(unsigned long key, unsigned long flags)
 
 void DocumentView::OnPaint()
 {
+	Trace::Span trace("paint");
+	auto paintStart = std::chrono::steady_clock::now();
 	PAINTSTRUCT ps;
 	auto hdc = ::BeginPaint(GetHWND(), &ps);
 
@@ -179,7 +196,9 @@ void DocumentView::OnPaint()
 
 	::SelectObject(compatibleDc, font.Get());
 
-	DrawDocument(compatibleDc);
+	DrawDocument(compatibleDc, clipBox);
+	if (showFrameTime)
+		DrawFrameTime(compatibleDc, client, paintStart);
 
 	::BitBlt(
 		hdc,
@@ -263,11 +282,22 @@ void DocumentView::OnMouseWheel(short delta, unsigned short flags, short x, shor
 
 void DocumentView::OnLButtonDown(unsigned long flags, short x, short y)
 {
-	::SetCapture(GetHWND());
 	auto position = GetDocumentPositionFromPoint(x, y);
-	selectingText = true;
 	auto shift = MATH::TestFlag(flags, MK_SHIFT);
 	auto alt = ::GetKeyState(VK_MENU) < 0;
+
+	//Ctrl+Alt+Click adds another caret instead of moving the current one
+	if (MATH::TestFlag(flags, MK_CONTROL) && alt && !shift)
+	{
+		DocumentSelection caret;
+		caret.SetStart(position);
+		caret.SetEnd(position);
+		document->AddSelection(caret);
+		return;
+	}
+
+	::SetCapture(GetHWND());
+	selectingText = true;
 	document->SelectPosition(position, shift, alt);
 	if (MATH::TestFlag(flags, MK_CONTROL))
 	{
@@ -326,6 +356,31 @@ void DocumentView::OnKillFocus(HWND next)
 	::DestroyCaret();
 }
 
+void DocumentView::OnTimer(UINT_PTR id)
+{
+	switch(id)
+	{
+	case openTimer:
+		//Pull in the lines indexed since the last tick (the document raises the redraw events)
+		document->UpdateOpen();
+		if (!document->IsOpening())
+			KillTimer(id);
+		break;
+	case findTimer:
+		//Search the next slice of lines (the document appends the results to the output)
+		document->UpdateFind();
+		if (!document->IsFinding())
+			KillTimer(id);
+		break;
+	case lexTimer:
+		//Merge the finished chunk of token runs and start lexing the next one
+		document->UpdateLexer();
+		if (!document->IsLexing())
+			KillTimer(id);
+		break;
+	}
+}
+
 void DocumentView::OnCommand(WORD code, WORD id, HWND hwnd)
 {
 	switch(id)
@@ -449,6 +504,9 @@ void DocumentView::OnCommand(WORD code, WORD id, HWND hwnd)
 	case ID_EDIT_PREVIOUS_BOOKMARK:
 		OnPreviousBookmark();
 		break;
+	case ID_EDIT_SELECT_ALL_MATCHES:
+		OnSelectAllMatches();
+		break;
 	}
 }
 
@@ -467,6 +525,13 @@ void DocumentView::SetScrollPos(POINT pt)
 }
 
 void DocumentView::UpdateScrollStatus()
+{
+	UpdateScrollBars();
+	Invalidate();
+	UpdateCaret();
+}
+
+void DocumentView::UpdateScrollBars()
 {
 	auto size = GetClientSize();
 	UpdateScrollBarStatus(SB_HORZ, size.cx, documentSize.cx);
@@ -476,8 +541,6 @@ void DocumentView::UpdateScrollStatus()
 	UpdateScrollBarStatus(SB_HORZ, size.cx, documentSize.cx);
 	size = GetClientSize();
 	UpdateScrollBarStatus(SB_VERT, size.cy, documentSize.cy);
-	Invalidate();
-	UpdateCaret();
 }
 
 void DocumentView::UpdateScrollBarStatus(int scrollBar, int visible, int total)
@@ -535,14 +598,29 @@ RECT DocumentView::GetViewRect()
 	return view;
 }
 
-void DocumentView::DrawDocument(HDC dc)
+void DocumentView::InvalidateLines(unsigned long firstLine, unsigned long endLine)
 {
+	auto view = GetViewRect();
+	auto first = MATH::Max(firstLine, static_cast<unsigned long>(view.top));
+	auto end = MATH::Min(endLine, static_cast<unsigned long>(view.bottom + 1));
+	if (first >= end)
+		return;
+
+	auto rect = GetClientRect();
+	rect.top += static_cast<long>(first - view.top) * charSize.cy;
+	rect.bottom = rect.top + static_cast<long>(end - first) * charSize.cy;
+	::InvalidateRect(GetHWND(), &rect, FALSE);
+}
+
+void DocumentView::DrawDocument(HDC dc, const RECT& clipBox)
+{
+	//Only the lines inside the clip box are drawn (after an edit that is usually just a few rows)
 	auto client = GetClientRect();
 	auto view = GetViewRect();
-	unsigned long firstVisibleLine = view.top;
-	unsigned long lastVisibleLine = MATH::Min(
-		static_cast<unsigned long>(view.bottom + 1),
-		document->GetLineCount());
+	unsigned long firstLine = view.top + MATH::Max(0l, clipBox.top - client.top) / charSize.cy;
+	unsigned long lastLine = MATH::Min(
+		static_cast<unsigned long>(view.top + (clipBox.bottom - client.top + charSize.cy - 1) / charSize.cy),
+		MATH::Min(static_cast<unsigned long>(view.bottom + 1), document->GetLineCount()));
 
 	auto selection = document->GetSelection();
 	auto isTextSelected =
@@ -567,19 +645,31 @@ void DocumentView::DrawDocument(HDC dc)
 	if (selection.IsVertical() && lastSelectedColumn < firstSelectedColumn)
 		std::swap(firstSelectedColumn, lastSelectedColumn);
 
-	int lineTop = client.top;
-	for (unsigned long index = firstVisibleLine; index < lastVisibleLine; ++index)
+	//Only the visible lines are searched for matches to highlight
+	auto matches = document->FindMatches(search, firstLine, lastLine);
+	auto nextMatch = matches.begin();
+	std::vector<DocumentSearch::Match> lineMatches;
+
+	//The other selections are highlighted like matches and their carets are drawn over the line
+	const auto& selections = document->GetSelections();
+	auto primarySelection = selections.Find(selection.GetEnd());
+	auto nextSelection = selections.FindFirstOnLine(firstLine);
+	std::vector<unsigned long> lineCarets;
+
+	renderCache.BeginFrame(dc, view.left, view.right, client.right - client.left - marginWidth, charSize.cy);
+	int lineTop = client.top + static_cast<int>(firstLine - view.top) * charSize.cy;
+	for (unsigned long index = firstLine; index < lastLine; ++index)
 	{
 		auto lineRect = client;
 		lineRect.top = lineTop;
 		lineRect.bottom = lineRect.top + charSize.cy;
 		lineTop += charSize.cy;
 
-		std::ostringstream out;
-		out << std::setw(marginLineNumberWidth) << std::setfill(' ') << (index + 1);
+		char lineNumber[16];
+		auto lineNumberLength = std::snprintf(lineNumber, sizeof(lineNumber), "%*lu", marginLineNumberWidth, index + 1);
 		::SetBkColor(dc, DocumentColor::marginBackground);
 		::SetTextColor(dc, DocumentColor::marginText);
-		::DrawText(dc, out.str().c_str(), marginLineNumberWidth, &lineRect, DT_LEFT|DT_SINGLELINE|DT_NOPREFIX);
+		::ExtTextOut(dc, lineRect.left, lineRect.top, 0, nullptr, lineNumber, lineNumberLength, nullptr);
 
 		if (document->IsLineBookmarked(index))
 		{
@@ -594,10 +684,8 @@ void DocumentView::DrawDocument(HDC dc)
 
 		lineRect.left += marginWidth;
 		auto isCurrentLine = selection.GetEndLine() == index;
-		if (isCurrentLine)
-			::FillRect(dc, &lineRect, currentLine);
-
 		const auto& text = document->GetLine(index);
+		const auto& runs = document->GetTokenRuns(index);
 
 		unsigned long selectedColumnStart = 0;
 		unsigned long selectedColumnEnd = 0;
@@ -607,20 +695,102 @@ void DocumentView::DrawDocument(HDC dc)
 			selectedColumnEnd = (index == lastSelectedLine || selection.IsVertical()) ? lastSelectedColumn : document->GetColumnWidth(index);
 		}
 
-		DocumentColor::DrawLine(
-			dc,
-			text,
-			lineRect.top,
-			lineRect.bottom,
-			lineRect.left,
-			charSize.cx,
-			view.left,
-			view.right,
-			selectedColumnStart,
-			selectedColumnEnd,
-			isCurrentLine,
-			isEmptyVerticalSelection && MATH::Between(firstSelectedLine, lastSelectedLine, index));
+		lineMatches.clear();
+		for (; nextMatch != matches.end() && nextMatch->line == index; ++nextMatch)
+			lineMatches.push_back(*nextMatch);
+
+		lineCarets.clear();
+		while (nextSelection < selections.GetCount() && DocumentSelectionSet::GetLast(selections.Get(nextSelection)).GetLine() < index)
+			++nextSelection;
+		for (auto other = nextSelection; other < selections.GetCount(); ++other)
+		{
+			auto first = DocumentSelectionSet::GetFirst(selections.Get(other));
+			auto last = DocumentSelectionSet::GetLast(selections.Get(other));
+			if (first.GetLine() > index)
+				break;
+			if (other == primarySelection)
+				continue;
+			if (selections.Get(other).GetEndLine() == index)
+				lineCarets.push_back(selections.Get(other).GetEndColumn());
+			if (first < last)
+			{
+				DocumentSearch::Match match = { index, 0, 0, 0, 0 };
+				match.firstColumn = first.GetLine() == index ? first.GetColumn() : 0;
+				match.lastColumn = last.GetLine() == index ? last.GetColumn() : document->GetColumnWidth(index);
+				lineMatches.push_back(match);
+			}
+		}
+		std::sort(lineMatches.begin(), lineMatches.end(), [](const DocumentSearch::Match& lhs, const DocumentSearch::Match& rhs)
+		{
+			return lhs.firstColumn < rhs.firstColumn;
+		});
+
+		//Lines that look the same as when they were last drawn are copied from the cache
+		DocumentRenderCache::Key key;
+		key.textHash = Hash::Fnv1a(text.data(), text.size());
+		key.textLength = text.size();
+		key.runs = runs;
+		key.selectedColumnStart = selectedColumnStart;
+		key.selectedColumnEnd = selectedColumnEnd;
+		key.matches = lineMatches;
+		key.isCurrentLine = isCurrentLine;
+		key.isEmptyVerticalSelection = isEmptyVerticalSelection && MATH::Between(firstSelectedLine, lastSelectedLine, index);
+		if (!renderCache.Draw(dc, key, lineRect.left, lineRect.top))
+		{
+			auto isEmptyVerticalSelectionLine = key.isEmptyVerticalSelection;
+			renderCache.Render(dc, std::move(key), lineRect.left, lineRect.top, [&](HDC lineDc, const RECT& rect)
+			{
+				::FillRect(lineDc, &rect, isCurrentLine ? currentLine : background);
+				DocumentColor::DrawLine(
+					lineDc,
+					text,
+					runs,
+					rect.top,
+					rect.bottom,
+					rect.left,
+					charSize.cx,
+					view.left,
+					view.right,
+					selectedColumnStart,
+					selectedColumnEnd,
+					lineMatches,
+					isCurrentLine,
+					isEmptyVerticalSelectionLine);
+			});
+		}
+
+		for (auto column: lineCarets)
+		{
+			if (column < static_cast<unsigned long>(view.left) || column > static_cast<unsigned long>(view.right))
+				continue;
+			auto caretRect = lineRect;
+			caretRect.left += static_cast<int>(column - view.left) * charSize.cx;
+			caretRect.right = caretRect.left + 2;
+			::FillRect(dc, &caretRect, caretBrush);
+		}
 	}
+	renderCache.EndFrame();
+}
+
+void DocumentView::DrawFrameTime(HDC dc, const RECT& client, std::chrono::steady_clock::time_point paintStart)
+{
+	//Show how long the paint took (up to the copy to the screen) and how many of its lines had to be
+	//drawn instead of copied from the cache.  It is only updated by paints that include the first row.
+	auto elapsed = static_cast<long>(std::chrono::duration_cast<std::chrono::microseconds>(
+		std::chrono::steady_clock::now() - paintStart).count());
+	char frameTime[64];
+	auto frameTimeLength = std::snprintf(
+		frameTime,
+		sizeof(frameTime),
+		" %ld.%03ld ms, %lu/%lu lines drawn ",
+		elapsed / 1000,
+		elapsed % 1000,
+		renderCache.GetRenderCount(),
+		renderCache.GetRenderCount() + renderCache.GetDrawCount());
+	::SetTextAlign(dc, TA_RIGHT|TA_TOP);
+	::SetBkColor(dc, DocumentColor::marginBackground);
+	::SetTextColor(dc, DocumentColor::marginText);
+	::ExtTextOut(dc, client.right, client.top, 0, nullptr, frameTime, frameTimeLength, nullptr);
 }
 
 void DocumentView::EnsureCaretVisible()
@@ -832,58 +1002,138 @@ void DocumentView::OnPreviousBookmark()
 	document->PreviousBookmark();
 }
 
+void DocumentView::OnSelectAllMatches()
+{
+	//Without a selection the word at the caret is matched (as a whole word)
+	auto wholeWord = false;
+	if (document->GetSelection().IsEmpty())
+	{
+		document->SelectPreviousWord(false, false, false);
+		document->SelectNextWord(true, false, false);
+		wholeWord = true;
+	}
+	auto text = document->GetSelectedText();
+	if (text.empty() || text.find('\n') != std::string::npos)
+		return;
+	document->SelectMatches(DocumentSearch(text, true, wholeWord, false));
+}
+
 void DocumentView::SetDocument(Document* document)
 {
 	static Document nullDocument;
 	if (this->document)
+	{
+		this->document->CancelFind();
 		this->document->SetEvents(nullptr);
+	}
 	this->document = document ? document : &nullDocument;
 	this->document->SetEvents(this);
+	caretLine = this->document->GetSelection().GetEndLine();
 
 	if (IsWindow())
 	{
 		Invalidate();
-		OnDocumentSizeChanged();
+		OnDocumentSizeChanged(documentMetrics, this->document->GetMetrics());
 		UpdateCaret();
+		if (this->document->IsOpening())
+			SetTimer(openTimer, 50);
+		SetTimer(lexTimer, 50);
 	}
 }
 
-void DocumentView::OnDocumentSizeChanged()
+void DocumentView::OnDocumentSizeChanged(const DocumentMetrics& oldMetrics, const DocumentMetrics& newMetrics)
 {
-	auto size = document->GetSize();
-	if (size.cx != documentSize.cx || size.cy != documentSize.cy)
-	{
-		documentSize = size;
-
-		marginWidth = bookmarkWidth;
-		marginLineNumberWidth = 0;
-		for (auto value = documentSize.cy; value > 0; value /= 10)
-			++marginLineNumberWidth;
-		marginWidth += marginLineNumberWidth * charSize.cx;
+	if (newMetrics == oldMetrics)
+		return;
+	documentMetrics = newMetrics;
+	documentSize = { static_cast<long>(newMetrics.GetMaxWidth()), static_cast<long>(newMetrics.GetLineCount()) };
 
-		UpdateScrollStatus();
+	//The margin only grows or shrinks when the line count gains or loses a digit
+	auto previousMarginWidth = marginWidth;
+	if (newMetrics.GetLineCount() != oldMetrics.GetLineCount())
+	{
+		marginLineNumberWidth = newMetrics.GetLineNumberDigits();
+		marginWidth = bookmarkWidth + marginLineNumberWidth * charSize.cx;
 	}
+
+	//Everything moves when the margin is resized or the view had to scroll back into the document,
+	//otherwise only the lines reported as changed are redrawn
+	auto scrollPosition = GetScrollPos();
+	UpdateScrollBars();
+	auto newScrollPosition = GetScrollPos();
+	if (marginWidth != previousMarginWidth ||
+		scrollPosition.x != newScrollPosition.x ||
+		scrollPosition.y != newScrollPosition.y)
+		Invalidate();
+	UpdateCaret();
 }
 
 void DocumentView::OnDocumentEditRegion(const DocumentPosition& start, const DocumentPosition& end)
 {
-	//TODO: Could make this function more efficient by determining the actual region to invalidate.
-	//      The double buffering of the paint routine hides most of the slowness.
-	//      If typing appears too slow then this function (and perhaps the function raising the event)
-	//      could be changed to update just the previously selected line, the currently selected line,
-	//      and only the portion of other lines that have had the selection changed.
-	Invalidate();
+	InvalidateLines(MATH::Min(start.GetLine(), end.GetLine()), MATH::Max(start.GetLine(), end.GetLine()) + 1);
+
+	//Restarting the timer waits for a pause in typing before the rest of the file is lexed again
+	SetTimer(lexTimer, 50);
+}
+
+void DocumentView::OnDocumentLinesChanged(const DocumentDamage& damage)
+{
+	//The lines after the damage did not change, they only moved by the lines inserted or removed.
+	//Their text is scrolled instead of drawn again, the margin stays since each row keeps its line number.
+	//A paint that is still pending would be scrolled onto the wrong lines, so then everything is redrawn.
+	auto shift = damage.GetLineShift();
+	if (shift != 0)
+	{
+		//The rows scroll from the old end, the clip starts at the new end when lines were removed
+		//so the rows that move up are painted too.
+		auto scrollPosition = GetScrollPos();
+		auto scrollRect = GetClientRect();
+		scrollRect.left += marginWidth;
+		auto clipRect = scrollRect;
+		scrollRect.top += MATH::Max(0l, static_cast<long>(damage.GetOldEndLine()) - scrollPosition.y) * charSize.cy;
+		clipRect.top += MATH::Max(0l, static_cast<long>(damage.GetMovedFirstLine()) - scrollPosition.y) * charSize.cy;
+		if (::GetUpdateRect(GetHWND(), nullptr, FALSE))
+			Invalidate();
+		else if (scrollRect.top < scrollRect.bottom)
+		{
+			::ScrollWindowEx(GetHWND(), 0, shift * charSize.cy, &scrollRect, &clipRect, nullptr, nullptr, SW_INVALIDATE);
+			//The frame time on the first row may have been scrolled along with the text
+			if (showFrameTime)
+				InvalidateLines(scrollPosition.y, scrollPosition.y + 1);
+		}
+		else
+			InvalidateLines(damage.GetMovedFirstLine(), damage.GetOldEndLine());
+
+		if (caretLine >= damage.GetOldEndLine())
+			caretLine = static_cast<unsigned long>(static_cast<long>(caretLine) + shift);
+
+		//Rows past the end of the document gain or lose their line numbers
+		auto lineCount = document->GetLineCount();
+		if (shift > 0)
+			InvalidateLines(lineCount - static_cast<unsigned long>(shift), lineCount);
+		else
+			InvalidateLines(lineCount, lineCount + static_cast<unsigned long>(-shift));
+	}
+	InvalidateLines(damage.GetFirstLine(), damage.GetEndLine());
 }
 
 void DocumentView::OnDocumentSelectionChanged()
 {
+	//The current line is highlighted, so the line the caret left is redrawn along with the line it is on
 	EnsureCaretVisible();
+	InvalidateLines(caretLine, caretLine + 1);
+	caretLine = document->GetSelection().GetEndLine();
+	InvalidateLines(caretLine, caretLine + 1);
 	UpdateCaret();
 	//TODO: update status bar position
 }
 
-void DocumentView::FindTextInDocument(const std::string& text)
+void DocumentView::FindTextInDocument(const DocumentSearch& search)
 {
-	document->FindTextInDocument(text, outputTarget);
+	this->search = search;
+	document->FindTextInDocument(search, outputTarget);
+	if (document->IsFinding())
+		SetTimer(findTimer, 10);
+	Invalidate();
 }
 
@@ -15,6 +15,8 @@
 #include "DocumentPosition.h"
 #include "FindInDocumentEvents.h"
 #include "OutputTarget.h"
+#include "DocumentRenderCache.h"
+#include <chrono>
 
 class DocumentView :
 	public WIN::CWindowImpl<DocumentView>,
@@ -48,15 +50,19 @@ public:
 	void OnSetFocus(HWND prev) override;
 	void OnKillFocus(HWND next) override;
 	void OnCommand(WORD code, WORD id, HWND hwnd) override;
+	void OnTimer(UINT_PTR id) override;
 
 	POINT GetScrollPos();
 	void SetScrollPos(POINT pt);
 	void UpdateScrollStatus();
+	void UpdateScrollBars();
 	void UpdateScrollBarStatus(int scrollBar, int visible, int total);
 	void UpdateCaret();
 	SIZE GetClientSize();
 	RECT GetViewRect();
-	void DrawDocument(HDC dc);
+	void InvalidateLines(unsigned long firstLine, unsigned long endLine);
+	void DrawDocument(HDC dc, const RECT& clipBox);
+	void DrawFrameTime(HDC dc, const RECT& client, std::chrono::steady_clock::time_point paintStart);
 	void EnsureCaretVisible();
 	void PageUp(bool extend, bool isVertical);
 	void PageDown(bool extend, bool isVertical);
@@ -72,14 +78,16 @@ public:
 	void OnToggleBookmark();
 	void OnNextBookmark();
 	void OnPreviousBookmark();
+	void OnSelectAllMatches();
 
 	void SetDocument(Document* document);
 
-	void OnDocumentSizeChanged() override;
+	void OnDocumentSizeChanged(const DocumentMetrics& oldMetrics, const DocumentMetrics& newMetrics) override;
 	void OnDocumentEditRegion(const DocumentPosition& start, const DocumentPosition& end) override;
+	void OnDocumentLinesChanged(const DocumentDamage& damage) override;
 	void OnDocumentSelectionChanged() override;
 
-	void FindTextInDocument(const std::string& text) override;
+	void FindTextInDocument(const DocumentSearch& search) override;
 
 private:
 	Document* document = nullptr;
@@ -87,13 +95,19 @@ private:
 	WIN::CBrush currentLine;
 	WIN::CBrush margin;
 	WIN::CBrush bookmarkBrush;
+	WIN::CBrush caretBrush;
 	WIN::CFont font;
 	TEXTMETRIC metrics = {0};
 	SIZE charSize = {0};
+	DocumentMetrics documentMetrics;
 	SIZE documentSize = {0};
 	int marginWidth = 0;
 	int marginLineNumberWidth = 0;
+	unsigned long caretLine = 0;
 	bool selectingText = false;
 	OutputTarget* outputTarget = nullptr;
+	DocumentSearch search;
+	DocumentRenderCache renderCache;
+	bool showFrameTime = false;
 };
 
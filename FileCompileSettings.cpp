@@ -7,7 +7,9 @@
 ////////////////////////////////////////////////////////////////////////////////
 #include "pch.h"
 #include "FileCompileSettings.h"
-#include "Process2.h"
+#include "Hash.h"
+#include "IncludeScanner.h"
+#include "Settings.h"
 
 void FileCompileSettings::SetProjectItemFile(Project* project, ProjectItemFile* projectItem)
 {
@@ -29,106 +31,45 @@ bool FileCompileSettings::IsModuleDefinitionFile() const
 	return STRING::upper(FSYS::GetFileExt(projectItem->GetName())) == "DEF";
 }
 
-bool FileCompileSettings::NeedsToCompile() const
+bool FileCompileSettings::NeedsToCompile(BuildDatabase& database) const
 {
 	auto extension = STRING::upper(FSYS::GetFileExt(projectItem->GetName()));
-	//There is no g++ dependency utility for RC files since they use windres to compile.
-	//We could optimize by scanning for include statements manually...
+	//RC files also reference icons, bitmaps and manifests that are not #include
+	//statements, so they are always compiled.
 	if (extension == "RC")
 		return true;
 
-	//Prepare to generate the dep file, but only do so if the output file
-	//already exists (because if the output file does not exist then we
-	//definitely need to
-	auto depFile = PrepareForCompile("dep");
-	auto outputFile = depFile.substr(0, depFile.size() - 3) + "o";
-	if (!FSYS::FileExists(outputFile))
+	//If the output file does not exist then we definitely need to compile.
+	BuildDatabase::Stamp output;
+	if (!BuildDatabase::ReadStamp(GetFullOutputFile("o"), output))
 		return true;
 
-	try
-	{
-		std::ostringstream out;
-		out << "g++ -MM -E -std=" << project->GetStandard()
-			<< " -c " << STRING::replace(projectItem->GetName(), "\\", "/");
-		for (const auto& includeDirectory: project->GetIncludeDirectories())
-			out << " -I " << includeDirectory;
-		out << " -MF " << GetOutputFile("dep");
-
-		Process::Shell(out.str(), FSYS::GetFilePath(project->GetFileName()), CREATE_NO_WINDOW, true);
-	}
-	catch (...)
-	{
-		//If any exception occurs attempting to determine if a file needs to compile
-		//then we can assume that it does need to compile.  Errors would be from the
-		//process call to generate the dep file.
-		return true;
-	}
-
-	//If for some reason the dep file did not get generated, assume we need to rebuild.
-	if (!FSYS::FileExists(depFile))
-		return true;
-
-	//Read the dependencies from the file
-	std::vector<std::string> dependencies;
-	std::ifstream in(depFile.c_str());
-	std::string line;
-	while (std::getline(in, line))
-	{
-		//Remove the trailing \ if it exists.
-		if (!line.empty() && line.back() == '\\')
-			line.pop_back();
-
-		//Ignore the output file name from the first line (goes to '.o:').
-		auto colon = line.find(".o:");
-		if (colon != std::string::npos)
-			line = line.substr(colon + 3);
-
-		//Trim leading and trailing spaces.
-		line = STRING::trim(line);
-		if (line.empty())
-			continue;
-
-		//Scan each file separated by spaces (note that "\ " indicates a space
-		//in an individual file name).
-		std::string::size_type position = 0;
-		for (;;)
-		{
-			auto next = line.find(' ', position + 1);
-			while (next != std::string::npos && line[next - 1] == '\\')
-				next = line.find(' ', next + 1);
-			if (next == std::string::npos)
-			{
-				dependencies.push_back(line.substr(position));
-				break;
-			}
-			else
-			{
-				dependencies.push_back(line.substr(position, next - position));
-				position = next + 1;
-			}
-		}
-	}
+	//The build database answers from the recorded command and file stamps alone.
+	//Only objects compiled with exactly the same command are reused, so changing
+	//a project setting rebuilds just the objects whose command line changed.  An
+	//object without a record was compiled by an unknown command and is rebuilt.
+	auto commandHash = Hash::Fnv1a(GetCompileCommand());
+	return database.Check(GetOutputFile("o"), commandHash, output) != BuildDatabase::State::upToDate;
+}
 
-	//Check the last modified date for the output file and return true if
-	//any of the dependencies has been modified after that time.
-	auto lastCompiled = FSYS::GetFileLastWriteTime(outputFile);
-	for (auto& dependency: dependencies)
+void FileCompileSettings::RecordCompile(BuildDatabase& database) const
+{
+	//Compiling deletes the previous output file first, so a failed compile leaves no output and no record.
+	BuildDatabase::Stamp output;
+	if (STRING::upper(FSYS::GetFileExt(projectItem->GetName())) == "RC" ||
+		!BuildDatabase::ReadStamp(GetFullOutputFile("o"), output))
+		return;
+
+	BuildDatabase::Record record;
+	record.commandHash = Hash::Fnv1a(GetCompileCommand());
+	record.output = output;
+	for (const auto& dependency: GetDependencies())
 	{
-		//Clean up dependecy file name (and skip files we can't find)
-		dependency = STRING::replace(dependency, "\\ ", " ");
-		dependency = STRING::replace(dependency, "/", "\\");
-		if (dependency.find(':') != 1)
-			dependency = FSYS::FormatPath(FSYS::GetFilePath(project->GetFileName()), dependency);
-		if (!FSYS::FileExists(dependency))
-			continue;
-
-		auto lastUpdated = FSYS::GetFileLastWriteTime(dependency);
-		if (lastUpdated > lastCompiled)
-			return true;
+		BuildDatabase::Stamp stamp;
+		if (database.GetStamp(dependency, stamp))
+			record.dependencies.push_back({ dependency, stamp });
 	}
-
-	//We checked all dependencies and none have changed - this file is up to date.
-	return false;
+	database.Update(GetOutputFile("o"), record);
 }
 
 const std::string& FileCompileSettings::GetFileName() const
@@ -138,9 +79,7 @@ const std::string& FileCompileSettings::GetFileName() const
 
 std::string FileCompileSettings::PrepareForCompile(const std::string& suffix) const
 {
-	auto outputFile = FSYS::FormatPath(
-		FSYS::GetFilePath(project->GetFileName()),
-		STRING::replace(GetOutputFile(suffix), "/", "\\"));
+	auto outputFile = GetFullOutputFile(suffix);
 	auto outputDirectory = FSYS::GetFilePath(outputFile);
 	//Make sure the output directory does exist
 	if (!FSYS::PathExists(outputDirectory))
@@ -207,4 +146,20 @@ std::string FileCompileSettings::GetOutputFile(const std::string& suffix) const
 	return out.str();
 }
 
+std::string FileCompileSettings::GetFullOutputFile(const std::string& suffix) const
+{
+	return FSYS::FormatPath(
+		FSYS::GetFilePath(project->GetFileName()),
+		STRING::replace(GetOutputFile(suffix), "/", "\\"));
+}
+
+std::vector<std::string> FileCompileSettings::GetDependencies() const
+{
+	return IncludeScanner::GetInstance().GetDependencies(
+		projectItem->GetName(),
+		FSYS::GetFilePath(project->GetFileName()),
+		project->GetIncludeDirectories(),
+		Settings().GetSystemIncludeDirectories());
+}
+
 
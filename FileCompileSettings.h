@@ -6,6 +6,7 @@
 // Author:      Jacob Buysse
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
+#include "BuildDatabase.h"
 #include "Project.h"
 #include "ProjectItem.h"
 #include <string>
@@ -23,12 +24,17 @@ public:
 
 	bool CanCompile() const;
 	bool IsModuleDefinitionFile() const;
-	bool NeedsToCompile() const;
+	bool NeedsToCompile(BuildDatabase& database) const;
+	void RecordCompile(BuildDatabase& database) const;
 	const std::string& GetFileName() const;
 	std::string PrepareForCompile(const std::string& suffix) const;
 	std::string GetCompileCommand() const;
 	std::string GetOutputFile(const std::string& suffix) const;
 
+private:
+	std::string GetFullOutputFile(const std::string& suffix) const;
+	std::vector<std::string> GetDependencies() const;
+
 private:
 	Project* project = nullptr;
 	ProjectItemFile* projectItem = nullptr;
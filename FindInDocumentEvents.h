@@ -6,11 +6,11 @@
 // Author:      Jacob Buysse
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
-#include <string>
+#include "DocumentSearch.h"
 
 class FindInDocumentEvents
 {
 public:
-	virtual void FindTextInDocument(const std::string& text) = 0;
+	virtual void FindTextInDocument(const DocumentSearch& search) = 0;
 };
 
@@ -8,6 +8,10 @@
 #include "FindInDocumentWindow.h"
 
 constexpr auto editLabelTextId = 1001;
+constexpr auto checkMatchCaseId = 1002;
+constexpr auto checkWholeWordId = 1003;
+constexpr auto checkRegexId = 1004;
+constexpr auto checkWidth = 100;
 
 void FindInDocumentWindow::SetupClass(WNDCLASSEX& cls)
 {
@@ -18,6 +22,12 @@ bool FindInDocumentWindow::OnCreate(CREATESTRUCT* cs)
 {
 	labelFindText.Attach(WIN::CWindow::Create(WC_STATIC, GetHWND(), nullptr, "Find: ", WS_CHILD | WS_VISIBLE | SS_CENTERIMAGE, 0, 0, 0, 40, 12, nullptr));
 	editFindText.Create(GetHWND(), editLabelTextId, "", WS_CHILD | WS_VISIBLE | ES_LEFT | ES_AUTOHSCROLL, WS_EX_CLIENTEDGE, { 40, 0, 100, 12 });
+	checkMatchCase.Attach(WIN::CWindow::Create(WC_BUTTON, GetHWND(), reinterpret_cast<HMENU>(checkMatchCaseId),
+		"Match Case", WS_CHILD | WS_VISIBLE | BS_AUTOCHECKBOX, 0, 0, 0, 1, 1, nullptr));
+	checkWholeWord.Attach(WIN::CWindow::Create(WC_BUTTON, GetHWND(), reinterpret_cast<HMENU>(checkWholeWordId),
+		"Whole Word", WS_CHILD | WS_VISIBLE | BS_AUTOCHECKBOX, 0, 0, 0, 1, 1, nullptr));
+	checkRegex.Attach(WIN::CWindow::Create(WC_BUTTON, GetHWND(), reinterpret_cast<HMENU>(checkRegexId),
+		"Regex", WS_CHILD | WS_VISIBLE | BS_AUTOCHECKBOX, 0, 0, 0, 1, 1, nullptr));
 
 	auto dc = ::GetDC(GetHWND());
 	font.Create("Courier New", WIN::CFont::CalcHeight(dc, 8));
@@ -25,6 +35,9 @@ bool FindInDocumentWindow::OnCreate(CREATESTRUCT* cs)
 
 	labelFindText.SetFont(font.Get());
 	editFindText.SetFont(font.Get());
+	checkMatchCase.SetFont(font.Get());
+	checkWholeWord.SetFont(font.Get());
+	checkRegex.SetFont(font.Get());
 
 	return true;
 }
@@ -37,7 +50,19 @@ void FindInDocumentWindow::OnSize(unsigned long flag, unsigned short w, unsigned
 	labelRect.right = 40;
 	labelFindText.Move(labelRect);
 	editRect.left = 40;
+	editRect.right = MATH::Max(editRect.left, client.right - 3 * checkWidth);
 	editFindText.Move(editRect);
+
+	auto checkRect = client;
+	checkRect.left = editRect.right;
+	checkRect.right = checkRect.left + checkWidth;
+	checkMatchCase.Move(checkRect);
+	checkRect.left += checkWidth;
+	checkRect.right += checkWidth;
+	checkWholeWord.Move(checkRect);
+	checkRect.left += checkWidth;
+	checkRect.right += checkWidth;
+	checkRegex.Move(checkRect);
 }
 
 void FindInDocumentWindow::OnCommand(WORD code, WORD id, HWND hwnd)
@@ -45,8 +70,14 @@ void FindInDocumentWindow::OnCommand(WORD code, WORD id, HWND hwnd)
 	switch(id)
 	{
 	case editLabelTextId:
-		if (code == EN_CHANGE && events != nullptr)
-			events->FindTextInDocument(editFindText.GetText());
+		if (code == EN_CHANGE)
+			FindText();
+		break;
+	case checkMatchCaseId:
+	case checkWholeWordId:
+	case checkRegexId:
+		if (code == BN_CLICKED)
+			FindText();
 		break;
 	}
 }
@@ -61,3 +92,14 @@ void FindInDocumentWindow::OnEditFind()
 	editFindText.SetFocus();
 }
 
+void FindInDocumentWindow::FindText()
+{
+	//The query (and regular expression) is compiled once each time the text or an option changes
+	if (events != nullptr)
+		events->FindTextInDocument(DocumentSearch(
+			editFindText.GetText(),
+			IsDlgItemChecked(checkMatchCaseId),
+			IsDlgItemChecked(checkWholeWordId),
+			IsDlgItemChecked(checkRegexId)));
+}
+
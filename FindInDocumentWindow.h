@@ -29,10 +29,16 @@ public:
 	void SetEvents(FindInDocumentEvents* events);
 	void OnEditFind();
 
+private:
+	void FindText();
+
 private:
 	friend class FindInDocumentWindowTest;
 	WIN::CWindow labelFindText;
 	WIN::CEdit editFindText;
+	WIN::CWindow checkMatchCase;
+	WIN::CWindow checkWholeWord;
+	WIN::CWindow checkRegex;
 	WIN::CFont font;
 	FindInDocumentEvents* events = nullptr;
 };
@@ -0,0 +1,88 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    FindInFilesThread.cpp
+// Description: This file implements all FindInFilesThread member functions.
+//
+// Created:     2026-10-17 22:31:46
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#include "pch.h"
+#include "FindInFilesThread.h"
+#include "TextSearch.h"
+#include "ThreadPool.h"
+#include "Trace.h"
+#include "WorkQueue.h"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+FindInFilesThread::FindInFilesThread(const std::string& findText, std::vector<File>&& files)
+	: findText(findText), files(std::move(files)), stopping(false), done(false)
+{
+	Start();
+}
+
+FindInFilesThread::~FindInFilesThread()
+{
+	//The application is closing, the files that have not started yet are skipped
+	stopping = true;
+	Stop();
+}
+
+void FindInFilesThread::Run()
+{
+	Trace::Span trace("find in files");
+
+	//Each file is searched on the shared pool into its own slot of the results
+	results.resize(files.size());
+	WorkQueue queue(ThreadPool::GetInstance());
+	for (auto index = 0ul; index < files.size(); ++index)
+		queue.Push([this, index]()
+		{
+			if (!stopping)
+				results[index] = FindInFile(files[index].first, files[index].second, findText);
+		});
+	queue.Wait();
+	done = true;
+}
+
+bool FindInFilesThread::IsDone() const
+{
+	return done;
+}
+
+const std::vector<std::string>& FindInFilesThread::GetResults() const
+{
+	return results;
+}
+
+std::string FindInFilesThread::FindInFile(const std::string& fileName, const std::string& relativeFileName, const std::string& findText)
+{
+	std::ostringstream buffer;
+	std::ifstream in(fileName.c_str());
+	buffer << in.rdbuf();
+	auto text = buffer.str();
+
+	//Search the whole file at once and only split out the lines containing a match
+	std::ostringstream out;
+	TextSearch search(findText);
+	auto end = text.data() + text.size();
+	auto lineNumber = 1ul;
+	for (auto lineStart = text.data(); lineStart < end; ++lineNumber)
+	{
+		auto match = search.Find(lineStart, end);
+		if (match == end)
+			break;
+
+		//Skip ahead to the start of the line containing the match
+		for (auto newLine = std::find(lineStart, match, '\n'); newLine != match; newLine = std::find(lineStart, match, '\n'))
+		{
+			lineStart = newLine + 1;
+			++lineNumber;
+		}
+		auto lineEnd = std::find(match, end, '\n');
+		if (match != lineEnd)
+			out << "0> " << relativeFileName << ":" << lineNumber << ":" << ((match - lineStart) + 1) << ": " << std::string(lineStart, lineEnd) << std::endl;
+		lineStart = lineEnd == end ? end : lineEnd + 1;
+	}
+	return STRING::replace(out.str(), "\n", "\r\n");
+}
@@ -0,0 +1,46 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    FindInFilesThread.h
+// Description: This file declares the FindInFilesThread class.  This thread
+//              searches the files of the project on the shared ThreadPool and
+//              waits for them, so the UI thread is not blocked while a build
+//              keeps the workers busy.  The results are kept in project order
+//              and read by the main frame once the thread is done.
+//
+// Created:     2026-10-17 22:31:46
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "BaseThread.h"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+class FindInFilesThread : public BaseThread
+{
+public:
+	typedef std::pair<std::string, std::string> File;
+
+	FindInFilesThread(const std::string& findText, std::vector<File>&& files);
+	FindInFilesThread(const FindInFilesThread& rhs) = delete;
+	~FindInFilesThread();
+
+	FindInFilesThread& operator=(const FindInFilesThread& rhs) = delete;
+
+	void Run() final;
+
+	bool IsDone() const;
+	const std::vector<std::string>& GetResults() const;
+
+	static std::string FindInFile(const std::string& fileName, const std::string& relativeFileName, const std::string& findText);
+
+private:
+	std::string findText;
+	std::vector<File> files;
+	std::vector<std::string> results;
+	std::atomic<bool> stopping;
+	std::atomic<bool> done;
+};
+
+typedef std::unique_ptr<FindInFilesThread> FindInFilesThreadPtr;
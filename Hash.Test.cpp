@@ -0,0 +1,32 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    Hash.Test.cpp
+// Description: This file defines all Hash unit tests.
+//
+// Created:     2026-10-17 21:52:34
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#include "Hash.h"
+#include <UnitTest/UnitTest.h>
+using UnitTest::Assert;
+
+TEST_CLASS(HashTest)
+{
+public:
+	HashTest()
+	{
+	}
+
+	TEST_METHOD(Fnv1aMatchesReferenceValues)
+	{
+		Assert::IsTrue(Hash::Fnv1a(std::string()) == 0xcbf29ce484222325ull);
+		Assert::IsTrue(Hash::Fnv1a("a") == 0xaf63dc4c8601ec8cull);
+		Assert::IsTrue(Hash::Fnv1a("foobar") == 0x85944171f73967e8ull);
+	}
+
+	TEST_METHOD(LengthLimitsText)
+	{
+		std::string text = "foobar";
+		Assert::IsTrue(Hash::Fnv1a(text.data(), 1) == Hash::Fnv1a("f"));
+		Assert::IsTrue(Hash::Fnv1a(text.data(), 3) != Hash::Fnv1a(text));
+	}
+};
@@ -0,0 +1,25 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    Hash.cpp
+// Description: This file implements all Hash member functions.
+//
+// Created:     2026-10-17 21:52:34
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#include "pch.h"
+#include "Hash.h"
+
+unsigned long long Hash::Fnv1a(const char* text, unsigned long length)
+{
+	auto hash = 14695981039346656037ull;
+	for (unsigned long index = 0; index < length; ++index)
+	{
+		hash ^= static_cast<unsigned char>(text[index]);
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+unsigned long long Hash::Fnv1a(const std::string& text)
+{
+	return Fnv1a(text.data(), text.size());
+}
@@ -0,0 +1,18 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    Hash.h
+// Description: This file declares the Hash class.  64-bit FNV-1a is used
+//              wherever text needs a cheap, stable hash (cached line bitmaps
+//              and the compile commands kept in the build database).
+//
+// Created:     2026-10-17 21:52:34
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <string>
+
+class Hash
+{
+public:
+	static unsigned long long Fnv1a(const char* text, unsigned long length);
+	static unsigned long long Fnv1a(const std::string& text);
+};
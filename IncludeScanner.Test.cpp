@@ -0,0 +1,52 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    IncludeScanner.Test.cpp
+// Description: This file defines all IncludeScanner unit tests.
+//
+// Created:     2026-10-17 20:31:17
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#include "IncludeScanner.h"
+#include <UnitTest/UnitTest.h>
+using UnitTest::Assert;
+
+TEST_CLASS(IncludeScannerTest)
+{
+public:
+	IncludeScannerTest()
+	{
+	}
+
+	TEST_METHOD(QuotedAndAngleIncludes)
+	{
+		auto includes = IncludeScanner::ParseIncludes(
+			"#include \"pch.h\"\n"
+			"  #  include <vector>\r\n"
+			"#include\t\"Sub/Header.h\" // trailing comment\n"
+			"#include MACRO_HEADER\n"
+			"#define include \"not.h\"\n"
+			"int include = 0;\n");
+		Assert::AreEqual(3ul, static_cast<unsigned long>(includes.size()));
+		Assert::AreEqual(std::string("pch.h"), includes[0].name);
+		Assert::IsTrue(includes[0].isQuoted);
+		Assert::AreEqual(std::string("vector"), includes[1].name);
+		Assert::IsTrue(!includes[1].isQuoted);
+		Assert::AreEqual(std::string("Sub/Header.h"), includes[2].name);
+		Assert::IsTrue(includes[2].isQuoted);
+	}
+
+	TEST_METHOD(CommentedIncludesAreIgnored)
+	{
+		auto includes = IncludeScanner::ParseIncludes(
+			"// #include \"line.h\"\n"
+			"/*\n"
+			"#include \"block.h\"\n"
+			"*/ #include \"after.h\"\n"
+			"int value; /* open\n"
+			"#include \"hidden.h\"\n"
+			"*/\n"
+			"/* short */ #include <last>\n");
+		Assert::AreEqual(2ul, static_cast<unsigned long>(includes.size()));
+		Assert::AreEqual(std::string("after.h"), includes[0].name);
+		Assert::AreEqual(std::string("last"), includes[1].name);
+	}
+};
@@ -0,0 +1,195 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    IncludeScanner.cpp
+// Description: This file implements all IncludeScanner member functions.
+//
+// Created:     2026-10-17 20:31:17
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#include "pch.h"
+#include "IncludeScanner.h"
+#include <fstream>
+#include <set>
+#include <sstream>
+
+IncludeScanner& IncludeScanner::GetInstance()
+{
+	//One cache for the process, headers are shared by every file and every build
+	static IncludeScanner scanner;
+	return scanner;
+}
+
+std::vector<IncludeScanner::Include> IncludeScanner::ParseIncludes(const std::string& text)
+{
+	std::vector<Include> includes;
+	auto inComment = false;
+	std::istringstream in(text);
+	for (std::string line; std::getline(in, line); )
+	{
+		//Block comments are skipped, the directive has to be the first thing on its line
+		std::string::size_type position = 0;
+		if (inComment)
+		{
+			position = line.find("*/");
+			if (position == std::string::npos)
+				continue;
+			position += 2;
+			inComment = false;
+		}
+		position = line.find_first_not_of(" \t", position);
+		if (position == std::string::npos)
+			continue;
+		if (line.compare(position, 2, "/*") == 0)
+		{
+			auto end = line.find("*/", position + 2);
+			if (end == std::string::npos)
+			{
+				inComment = true;
+				continue;
+			}
+			position = line.find_first_not_of(" \t", end + 2);
+			if (position == std::string::npos)
+				continue;
+		}
+		if (line[position] != '#')
+		{
+			//A comment opened later on a line of code still hides the lines after it
+			auto open = line.rfind("/*");
+			inComment = open != std::string::npos && line.find("*/", open + 2) == std::string::npos && line.find("//") > open;
+			continue;
+		}
+
+		position = line.find_first_not_of(" \t", position + 1);
+		if (position == std::string::npos || line.compare(position, 7, "include") != 0)
+			continue;
+		position = line.find_first_not_of(" \t", position + 7);
+		if (position == std::string::npos || (line[position] != '"' && line[position] != '<'))
+			continue;
+		auto isQuoted = line[position] == '"';
+		auto end = line.find(isQuoted ? '"' : '>', position + 1);
+		if (end == std::string::npos || end == position + 1)
+			continue;
+		includes.push_back({ line.substr(position + 1, end - position - 1), isQuoted });
+	}
+	return includes;
+}
+
+bool IncludeScanner::GetLastWriteTime(const std::string& fileName, unsigned long long& value)
+{
+	WIN32_FILE_ATTRIBUTE_DATA data;
+	if (!::GetFileAttributesEx(fileName.c_str(), GetFileExInfoStandard, &data) ||
+		(data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0)
+		return false;
+	value = (static_cast<unsigned long long>(data.ftLastWriteTime.dwHighDateTime) << 32) | data.ftLastWriteTime.dwLowDateTime;
+	return true;
+}
+
+std::vector<std::string> IncludeScanner::GetDependencies(
+	const std::string& fileName,
+	const std::string& projectDirectory,
+	const std::list<std::string>& includeDirectories,
+	const std::vector<std::string>& systemIncludeDirectories)
+{
+	//Include directories are relative to the project, the same as for the g++ -I option
+	std::vector<std::string> userDirectories;
+	for (const auto& includeDirectory: includeDirectories)
+		userDirectories.push_back(GetFullPath(projectDirectory, includeDirectory));
+	std::vector<std::string> systemDirectories;
+	for (const auto& systemIncludeDirectory: systemIncludeDirectories)
+		systemDirectories.push_back(STRING::lower(GetFullPath(projectDirectory, systemIncludeDirectory)) + "\\");
+
+	//Includes are resolved once per including directory (angle includes once for all of them).
+	//An empty result is a system header or a file that could not be found, neither is followed.
+	//A system directory also given with -I still counts as a system directory.
+	auto isSystem = [&](const std::string& fileName)
+	{
+		auto key = STRING::lower(fileName);
+		for (const auto& systemDirectory: systemDirectories)
+			if (key.compare(0, systemDirectory.size(), systemDirectory) == 0)
+				return true;
+		return false;
+	};
+	auto resolve = [&](const Include& include, const std::string& directory)
+	{
+		if (include.isQuoted)
+		{
+			auto local = GetFullPath(directory, include.name);
+			if (FileExists(local))
+				return isSystem(local) ? std::string() : local;
+		}
+		for (const auto& userDirectory: userDirectories)
+		{
+			auto found = GetFullPath(userDirectory, include.name);
+			if (FileExists(found))
+				return isSystem(found) ? std::string() : found;
+		}
+		return std::string();
+	};
+	std::map<std::string, std::string> resolved;
+
+	//The source file comes first, a missing source file has no dependencies
+	std::vector<std::string> dependencies;
+	std::set<std::string> visited;
+	std::vector<std::string> pending{ GetFullPath(projectDirectory, fileName) };
+	while (!pending.empty())
+	{
+		auto current = pending.back();
+		pending.pop_back();
+		if (!visited.insert(STRING::lower(current)).second)
+			continue;
+
+		unsigned long long lastWriteTime = 0;
+		if (!GetLastWriteTime(current, lastWriteTime))
+			continue;
+		dependencies.push_back(current);
+
+		auto directory = FSYS::GetFilePath(current);
+		for (const auto& include: GetIncludes(current, lastWriteTime))
+		{
+			auto key = (include.isQuoted ? directory + "\"" : std::string("<")) + include.name;
+			auto iter = resolved.find(key);
+			if (iter == resolved.end())
+				iter = resolved.insert({ key, resolve(include, directory) }).first;
+			if (!iter->second.empty())
+				pending.push_back(iter->second);
+		}
+	}
+	return dependencies;
+}
+
+std::string IncludeScanner::GetFullPath(const std::string& directory, const std::string& fileName)
+{
+	//Normalized so that the same header reached through different relative paths is one file
+	auto path = STRING::replace(fileName, "/", "\\");
+	if (path.find(':') != 1 && path.compare(0, 2, "\\\\") != 0)
+		path = FSYS::FormatPath(directory, path);
+	char buffer[MAX_PATH];
+	auto length = ::GetFullPathName(path.c_str(), MAX_PATH, buffer, nullptr);
+	return length > 0 && length < MAX_PATH ? std::string(buffer, length) : path;
+}
+
+bool IncludeScanner::FileExists(const std::string& fileName)
+{
+	auto attributes = ::GetFileAttributes(fileName.c_str());
+	return attributes != INVALID_FILE_ATTRIBUTES && (attributes & FILE_ATTRIBUTE_DIRECTORY) == 0;
+}
+
+std::vector<IncludeScanner::Include> IncludeScanner::GetIncludes(const std::string& fileName, unsigned long long lastWriteTime)
+{
+	auto key = STRING::lower(fileName);
+	{
+		std::lock_guard<std::mutex> guard(headersLock);
+		auto iter = headers.find(key);
+		if (iter != headers.end() && iter->second.lastWriteTime == lastWriteTime)
+			return iter->second.includes;
+	}
+
+	//Read outside the lock, two jobs reading the same new header store the same result
+	std::ostringstream buffer;
+	std::ifstream in(fileName.c_str());
+	buffer << in.rdbuf();
+	auto includes = ParseIncludes(buffer.str());
+
+	std::lock_guard<std::mutex> guard(headersLock);
+	headers[key] = { lastWriteTime, includes };
+	return includes;
+}
@@ -0,0 +1,66 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    IncludeScanner.h
+// Description: This file declares the IncludeScanner class.  The scanner
+//              lists the files a source file depends on by following its
+//              #include directives in process (instead of running g++ -MM for
+//              every file).  The include list of each file is cached with the
+//              file's last write time, so scanning again after a change only
+//              reads the changed files.  Headers found in a system include directory
+//              are not followed, the same as g++ -MM.  Includes are followed
+//              regardless of conditional compilation, which at worst compiles a
+//              file that did not need it.
+//
+// Created:     2026-10-17 20:31:17
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class IncludeScanner
+{
+public:
+	struct Include
+	{
+		std::string name;
+		bool isQuoted;
+	};
+
+	IncludeScanner() = default;
+	IncludeScanner(const IncludeScanner& rhs) = delete;
+	~IncludeScanner() = default;
+
+	IncludeScanner& operator=(const IncludeScanner& rhs) = delete;
+
+	static IncludeScanner& GetInstance();
+	static std::vector<Include> ParseIncludes(const std::string& text);
+	static bool GetLastWriteTime(const std::string& fileName, unsigned long long& value);
+
+	std::vector<std::string> GetDependencies(
+		const std::string& fileName,
+		const std::string& projectDirectory,
+		const std::list<std::string>& includeDirectories,
+		const std::vector<std::string>& systemIncludeDirectories);
+
+private:
+	friend class IncludeScannerTest;
+
+	struct Header
+	{
+		unsigned long long lastWriteTime;
+		std::vector<Include> includes;
+	};
+
+	static std::string GetFullPath(const std::string& directory, const std::string& fileName);
+	static bool FileExists(const std::string& fileName);
+
+	std::vector<Include> GetIncludes(const std::string& fileName, unsigned long long lastWriteTime);
+
+private:
+	std::mutex headersLock;
+	std::unordered_map<std::string, Header> headers;
+};
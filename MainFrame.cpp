@@ -25,11 +25,12 @@
 #include "BuildThread.h"
 #include "Process2.h"
 #include "Settings.h"
+#include "Trace.h"
 #include "resource.h"
 #include <cstring>
-#include <future>
 
 const UINT_PTR buildTimer = 1;
+const UINT_PTR findInFilesTimer = 2;
 
 MainFrame::MainFrame()
 	: stoppingBuild(false)
@@ -217,6 +218,9 @@ void MainFrame::OnCommand(WORD code, WORD id, HWND hwnd)
 	case ID_TOOLS_EDIT_OPTIONS:
 		OnToolsEditOptions();
 		break;
+	case ID_TOOLS_SAVE_TRACE:
+		OnToolsSaveTrace();
+		break;
 	case ID_EDIT_SWITCH_DOCUMENTS:
 		OnEditSwitchDocuments();
 		break;
@@ -257,6 +261,19 @@ void MainFrame::OnTimer(UINT_PTR id)
 			buildThread.reset();
 		}
 		break;
+	case findInFilesTimer:
+		if (!findInFilesThread)
+		{
+			KillTimer(id);
+		}
+		else if (findInFilesThread->IsDone())
+		{
+			KillTimer(id);
+			for (const auto& result: findInFilesThread->GetResults())
+				outputWindow->Append(result);
+			findInFilesThread.reset();
+		}
+		break;
 	}
 }
 
@@ -648,7 +665,7 @@ void MainFrame::OnBuildCompile()
 	stoppingBuild = false;
 	buildThread.reset(new BuildThread());
 	buildThread->AddFileCompileSettings(setting);
-	buildThread->Build(this, 1, FSYS::GetFilePath(project.GetFileName()));
+	buildThread->Build(this, 1, FSYS::GetFilePath(project.GetFileName()), project.GetBuildDatabaseFile());
 	SetTimer(buildTimer, 10);
 }
 
@@ -741,7 +758,7 @@ void MainFrame::OnBuildBuild()
 		buildThread->MakeProjectTarget(&project, objects);
 	if (!testObjects.empty() && buildVisitor.GetBuildUnitTest())
 		buildThread->MakeProjectUnitTest(&project, testObjects);
-	buildThread->Build(this, 1, FSYS::GetFilePath(project.GetFileName()));
+	buildThread->Build(this, 1, FSYS::GetFilePath(project.GetFileName()), project.GetBuildDatabaseFile());
 	SetTimer(buildTimer, 10);
 }
 
@@ -836,11 +853,9 @@ void MainFrame::OnFileProjectSettings()
 
 	ProjectSettingsDialog dlg;
 	dlg.SetProject(&project);
+	//Objects whose compile command changed are rebuilt by the next build (no clean needed)
 	if (dlg.DoModal(GetHWND()) == IDOK)
-	{
-		OnBuildClean();
 		projectWindow.UpdateProjectName();
-	}
 }
 
 void MainFrame::OnBuildExecuteUnitTest()
@@ -920,63 +935,45 @@ void MainFrame::OnEditGotoLine()
 
 void MainFrame::OnEditFindInFiles()
 {
-	if (!project.IsOpen())
+	if (!project.IsOpen() || findInFilesThread)
 		return;
 	FindInFilesDialog dlg;
 	if (dlg.DoModal(GetHWND()) == IDOK)
 	{
 		auto findText = dlg.GetFindText();
 
+		//Only the file names are collected here, the files are searched by the thread
 		class FindVisitor : public ProjectItemVisitor
 		{
 		public:
-			FindVisitor(Project* project, std::string findText)
-				: project(project), findText(findText)
+			FindVisitor(Project* project)
+				: project(project)
 			{
 			}
 			void VisitFile(ProjectItemFile& file) override
 			{
 				auto relativeFileName = file.GetName();
 				auto fileName = FSYS::FormatPath(FSYS::GetFilePath(project->GetFileName()), relativeFileName);
-				results.emplace_back(std::async(&FindVisitor::FindInFile, fileName, relativeFileName, findText));
+				files.push_back({ fileName, relativeFileName });
 			}
 			void VisitFolder(ProjectItemFolder& folder) override
 			{
 				//nothing
 			}
 
-			static std::string FindInFile(std::string fileName, std::string relativeFileName, std::string findText)
-			{
-				std::ostringstream out;
-				std::ifstream in(fileName.c_str());
-				auto lineNumber = 1ul;
-				for (std::string line; std::getline(in, line); ++lineNumber)
-				{
-					auto iter = std::search(line.begin(), line.end(), findText.begin(), findText.end(), STRING::iequal_char());
-					if (iter != line.end())
-						out << "0> " << relativeFileName << ":" << lineNumber << ":" << ((iter - line.begin()) + 1) << ": " << line << std::endl;
-				}
-				return STRING::replace(out.str(), "\n", "\r\n");
-			}
-
-			void Finish(OutputTarget* outputTarget)
-			{
-				outputTarget->Clear();
-				outputTarget->Append("Find in files results for '" + findText + "'.\r\n");
-				for (auto& result: results)
-					outputTarget->Append(result.get());
-			}
+			std::vector<FindInFilesThread::File> files;
 
 		private:
 			Project* project = nullptr;
-			std::string findText;
-			std::vector<std::future<std::string>> results;
 		};
 
-		FindVisitor visitor(&project, findText);
+		FindVisitor visitor(&project);
 		project.GetRootFolder().Visit(&visitor);
+		outputWindow->Clear();
+		outputWindow->Append("Find in files results for '" + findText + "'.\r\n");
 		toolWindow.ShowOutputWindow();
-		visitor.Finish(outputWindow);
+		findInFilesThread.reset(new FindInFilesThread(findText, std::move(visitor.files)));
+		SetTimer(findInFilesTimer, 10);
 	}
 }
 
@@ -986,6 +983,36 @@ void MainFrame::OnToolsEditOptions()
 	dlg.DoModal(GetHWND());
 }
 
+void MainFrame::OnToolsSaveTrace()
+{
+	static const auto SIZE = 1024ul;
+	char buffer[SIZE] = "trace.json";
+
+	OPENFILENAME ofn;
+	std::memset(&ofn, 0, sizeof(ofn));
+	ofn.lStructSize = sizeof(ofn);
+	ofn.hwndOwner = GetHWND();
+	ofn.lpstrFilter = "Chrome Trace Files\0*.json\0";
+	ofn.nFilterIndex = 1;
+	ofn.lpstrFile = buffer;
+	ofn.nMaxFile = SIZE;
+	ofn.lpstrDefExt = "json";
+	ofn.lpstrTitle = "Save Trace";
+	ofn.Flags = OFN_OVERWRITEPROMPT | OFN_HIDEREADONLY;
+	if (!::GetSaveFileName(&ofn))
+		return;
+
+	try
+	{
+		Trace::SaveChromeTrace(buffer);
+		outputWindow->Append("Trace saved to " + std::string(buffer) + "\r\n");
+	}
+	catch (const std::exception& error)
+	{
+		MsgBox(error.what(), "Error", MB_OK|MB_ICONERROR);
+	}
+}
+
 void MainFrame::OnEditSwitchDocuments()
 {
 	if (documentWindow.HasFocus())
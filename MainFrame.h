@@ -17,6 +17,7 @@
 #include "DocumentWindowEvents.h"
 #include "CompileThreadEvents.h"
 #include "BuildThread.h"
+#include "FindInFilesThread.h"
 #include "ToolWindow.h"
 #include "FileLocation.h"
 #include "TopLevelEvents.h"
@@ -78,6 +79,7 @@ public:
 	void OnEditGotoLine();
 	void OnEditFindInFiles();
 	void OnToolsEditOptions();
+	void OnToolsSaveTrace();
 	void OnEditSwitchDocuments();
 
 	void OnProjectOpenFile(const std::string& fileName, bool openInOther) override;
@@ -104,6 +106,7 @@ private:
 	ToolWindow toolWindow;
 	Project project;
 	BuildThreadPtr buildThread;
+	FindInFilesThreadPtr findInFilesThread;
 	std::atomic<bool> stoppingBuild;
 };
 
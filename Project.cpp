@@ -413,6 +413,11 @@ std::string Project::GetTargetUnitTestFile() const
 	return FSYS::FormatPath(GetOutputPath(), GetUnitTestFile());
 }
 
+std::string Project::GetBuildDatabaseFile() const
+{
+	return FSYS::FormatPath(GetOutputPath(), "build.db");
+}
+
 std::string Project::GetExecutableFile() const
 {
 	return STRING::replace(outputFileName, "{ProjectName}", GetName());
@@ -72,6 +72,7 @@ public:
 	std::string GetOutputPath() const;
 	std::string GetTargetFile() const;
 	std::string GetTargetUnitTestFile() const;
+	std::string GetBuildDatabaseFile() const;
 	std::string GetExecutableFile() const;
 	std::string GetUnitTestFile() const;
 	std::string GetRelativeFileName(const std::string& fileName) const;
@@ -8,6 +8,8 @@
 #include "Settings.h"
 #include <CRL/StringUtility.h>
 #include <iterator>
+#include <cstdlib>
+#include <sstream>
 
 constexpr auto systemIncludeDirectoriesName = "SystemIncludeDirectories";
 constexpr auto systemIncludeDirectoriesDefault =
@@ -15,6 +17,12 @@ constexpr auto systemIncludeDirectoriesDefault =
 	R"(c:\program files\mingw\lib\gcc\x86_64-w64-mingw32\4.7.0\include;)"
 	R"(c:\program files\mingw\lib\gcc\x86_64-w64-mingw32\4.7.0\include\c++;)"
 	R"(c:\program files\mingw\lib\gcc\x86_64-w64-mingw32\4.7.0\include\c++\x86_64-w64-mingw32)";
+constexpr auto undoBudgetName = "UndoBudget";
+constexpr auto undoBudgetDefault = "16777216";
+constexpr auto workerThreadCountName = "WorkerThreadCount";
+constexpr auto workerThreadCountDefault = "0";
+constexpr auto showFrameTimeName = "ShowFrameTime";
+constexpr auto showFrameTimeDefault = "0";
 
 std::vector<std::string> Settings::GetSystemIncludeDirectories()
 {
@@ -29,3 +37,40 @@ void Settings::SetSystemIncludeDirectories(const std::vector<std::string>& value
 	SetString(systemIncludeDirectoriesName, STRING::join(value, ";"));
 }
 
+unsigned long Settings::GetUndoBudget()
+{
+	//Maximum number of bytes of undo history kept per document
+	return std::strtoul(GetString(undoBudgetName, undoBudgetDefault).c_str(), nullptr, 10);
+}
+
+void Settings::SetUndoBudget(unsigned long value)
+{
+	std::ostringstream out;
+	out << value;
+	SetString(undoBudgetName, out.str());
+}
+
+unsigned long Settings::GetWorkerThreadCount()
+{
+	//Number of threads shared by builds, unit tests and find in files (zero uses every hardware thread)
+	return std::strtoul(GetString(workerThreadCountName, workerThreadCountDefault).c_str(), nullptr, 10);
+}
+
+void Settings::SetWorkerThreadCount(unsigned long value)
+{
+	std::ostringstream out;
+	out << value;
+	SetString(workerThreadCountName, out.str());
+}
+
+
+bool Settings::GetShowFrameTime()
+{
+	//Draws the paint time in the corner of each document view (for measuring the renderer)
+	return GetString(showFrameTimeName, showFrameTimeDefault) != "0";
+}
+
+void Settings::SetShowFrameTime(bool value)
+{
+	SetString(showFrameTimeName, value ? "1" : "0");
+}
@@ -21,5 +21,11 @@ public:
 
 	std::vector<std::string> GetSystemIncludeDirectories();
 	void SetSystemIncludeDirectories(const std::vector<std::string>& value);
+	unsigned long GetUndoBudget();
+	void SetUndoBudget(unsigned long value);
+	unsigned long GetWorkerThreadCount();
+	void SetWorkerThreadCount(unsigned long value);
+	bool GetShowFrameTime();
+	void SetShowFrameTime(bool value);
 };
 
@@ -6,6 +6,7 @@
 // Author:      Jacob Buysse
 ////////////////////////////////////////////////////////////////////////////////
 #include "TestManagerThread.h"
+#include "WorkQueue.h"
 
 void TestManagerThread::AddUnitTest(unsigned long testIndex, const std::string& command)
 {
@@ -28,25 +29,15 @@ void TestManagerThread::Run()
 {
 	try
 	{
-		while (!pending.empty())
-		{
-			while (workers.size() < std::thread::hardware_concurrency() && !pending.empty())
+		WorkQueue queue(ThreadPool::GetInstance());
+		for (const auto& test: pending)
+			queue.Push([this, &test]()
 			{
-				auto worker = std::make_shared<UnitTestThread>();
-				const auto& test = pending.front();
-				worker->SetTestData(test.testIndex, test.command, workingDirectory, target);
-				workers.push_back(worker);
-				pending.pop_front();
-			}
-			TidyWorkers();
-			std::this_thread::yield();
-		}
-
-		while (!workers.empty())
-		{
-			TidyWorkers();
-			std::this_thread::yield();
-		}
+				UnitTestThread worker;
+				worker.SetTestData(test.testIndex, test.command, workingDirectory, target);
+				worker.Run();
+			});
+		queue.Wait();
 	}
 	catch (...)
 	{
@@ -55,14 +46,3 @@ void TestManagerThread::Run()
 	done = true;
 }
 
-void TestManagerThread::TidyWorkers()
-{
-	for (auto iter = workers.begin(); iter != workers.end(); )
-	{
-		if ((*iter)->IsDone())
-			iter = workers.erase(iter);
-		else
-			++iter;
-	}
-}
-
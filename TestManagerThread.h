@@ -11,7 +11,6 @@
 #include "TestResultsTarget.h"
 #include <string>
 #include <memory>
-#include <vector>
 #include <atomic>
 #include <deque>
 
@@ -30,9 +29,6 @@ public:
 		
 	void Run() final;
 
-private:
-	void TidyWorkers();
-
 private:
 	struct TestData
 	{
@@ -42,7 +38,6 @@ private:
 	TestResultsTarget* target = nullptr;
 	std::string workingDirectory;
 	std::deque<TestData> pending;
-	std::vector<UnitTestThreadPtr> workers;
 	std::atomic<bool> done;
 };
 
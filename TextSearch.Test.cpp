@@ -0,0 +1,95 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    TextSearch.Test.cpp
+// Description: This file defines all TextSearch unit tests.
+//
+// Created:     2026-10-17 13:31:08
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#include "TextSearch.h"
+#include <UnitTest/UnitTest.h>
+#include <algorithm>
+#include <random>
+#include <chrono>
+#include <cctype>
+#include <iostream>
+using UnitTest::Assert;
+
+TEST_CLASS(TextSearchTest)
+{
+public:
+	TextSearchTest()
+	{
+	}
+
+	TEST_METHOD(FindIgnoresCase)
+	{
+		TextSearch search("GetLine");
+		Assert::AreEqual(7ul, static_cast<unsigned long>(search.Find("return getline(index);")));
+		Assert::AreEqual(0ul, static_cast<unsigned long>(search.Find("GETLINE")));
+		Assert::IsTrue(search.Find("GetLin") == std::string::npos);
+		Assert::IsTrue(search.Find("Get_Line") == std::string::npos);
+	}
+
+	TEST_METHOD(FindPunctuationExactly)
+	{
+		//@ and ` differ from letters only by the case bit and must not be folded
+		TextSearch search("@x[");
+		Assert::IsTrue(search.Find("`x{ `X[") == std::string::npos);
+		Assert::AreEqual(4ul, static_cast<unsigned long>(search.Find("`x{ @X[")));
+	}
+
+	TEST_METHOD(RandomTextMatchesStdSearch)
+	{
+		std::mt19937 random(2468);
+		const std::string alphabet = "aAbB@`[{_ ";
+		for (auto iteration = 0; iteration < 2000; ++iteration)
+		{
+			std::string text, pattern;
+			auto textSize = random() % 100;
+			for (auto index = 0ul; index < textSize; ++index)
+				text += alphabet[random() % alphabet.size()];
+			auto patternSize = 1 + random() % 4;
+			for (auto index = 0ul; index < patternSize; ++index)
+				pattern += alphabet[random() % alphabet.size()];
+
+			Assert::AreEqual(
+				static_cast<unsigned long>(StdSearch(text, pattern)),
+				static_cast<unsigned long>(TextSearch(pattern).Find(text)));
+		}
+	}
+
+	TEST_METHOD(FindMatchesStdSearch)
+	{
+		//Benchmark against the previous std::search with a case insensitive comparison functor
+		std::string text;
+		for (auto index = 0; text.size() < 8 * 1024 * 1024; ++index)
+			text += "\tauto value = document.GetLineCount() + CalculateWidth(index);\n";
+		text += "FindTextInDocument";
+		const std::string pattern = "findtextindocument";
+
+		auto start = std::chrono::steady_clock::now();
+		auto expected = StdSearch(text, pattern);
+		auto stdTime = std::chrono::steady_clock::now() - start;
+
+		start = std::chrono::steady_clock::now();
+		auto actual = TextSearch(pattern).Find(text);
+		auto searchTime = std::chrono::steady_clock::now() - start;
+
+		Assert::AreEqual(static_cast<unsigned long>(expected), static_cast<unsigned long>(actual));
+
+		//Tests run in parallel, so the timings are only reported (the runner reads the result from standard output)
+		std::cerr << "TextSearch " << std::chrono::duration_cast<std::chrono::microseconds>(searchTime).count()
+			<< " us, std::search " << std::chrono::duration_cast<std::chrono::microseconds>(stdTime).count() << " us" << std::endl;
+	}
+
+private:
+	static std::string::size_type StdSearch(const std::string& text, const std::string& pattern)
+	{
+		auto iter = std::search(text.begin(), text.end(), pattern.begin(), pattern.end(), [](char lhs, char rhs)
+		{
+			return std::tolower(lhs) == std::tolower(rhs);
+		});
+		return iter == text.end() ? std::string::npos : iter - text.begin();
+	}
+};
+
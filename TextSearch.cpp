@@ -0,0 +1,117 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    TextSearch.cpp
+// Description: This file implements all TextSearch member functions.
+//
+// Created:     2026-10-17 13:31:08
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#include "pch.h"
+#include "TextSearch.h"
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+TextSearch::TextSearch(const std::string& pattern)
+{
+	this->pattern.reserve(pattern.size());
+	for (auto c: pattern)
+		this->pattern += Fold(c);
+}
+
+std::string::size_type TextSearch::Find(const std::string& text) const
+{
+	auto begin = text.data();
+	auto end = begin + text.size();
+	auto position = Find(begin, end);
+	return position == end ? std::string::npos : position - begin;
+}
+
+const char* TextSearch::Find(const char* begin, const char* end) const
+{
+	//Empty patterns match at the start (same as std::search)
+	if (pattern.empty())
+		return begin;
+	if (static_cast<std::string::size_type>(end - begin) < pattern.size())
+		return end;
+
+	//Candidates are the positions where both the first and last byte of the pattern match
+	auto last = end - pattern.size() + 1;
+	auto offset = pattern.size() - 1;
+	auto position = begin;
+
+#if defined(__AVX2__) || defined(__SSE2__)
+	//Setting the 0x20 bit folds exactly the upper case letters onto the lower case letters,
+	//so it is only applied when the pattern byte is a letter (other bytes compare exactly)
+	const char firstMask = IsLetter(pattern.front()) ? 0x20 : 0;
+	const char lastMask = IsLetter(pattern.back()) ? 0x20 : 0;
+#endif
+
+#ifdef __AVX2__
+	const auto firstByte = _mm256_set1_epi8(pattern.front());
+	const auto lastByte = _mm256_set1_epi8(pattern.back());
+	const auto firstFold = _mm256_set1_epi8(firstMask);
+	const auto lastFold = _mm256_set1_epi8(lastMask);
+	for (; last - position >= 32; position += 32)
+	{
+		auto firstBlock = _mm256_or_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(position)), firstFold);
+		auto lastBlock = _mm256_or_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(position + offset)), lastFold);
+		auto mask = static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_and_si256(
+			_mm256_cmpeq_epi8(firstBlock, firstByte),
+			_mm256_cmpeq_epi8(lastBlock, lastByte))));
+		for (; mask != 0; mask &= mask - 1)
+		{
+			auto candidate = position + __builtin_ctz(mask);
+			if (Matches(candidate))
+				return candidate;
+		}
+	}
+#endif
+
+#ifdef __SSE2__
+	const auto firstByte16 = _mm_set1_epi8(pattern.front());
+	const auto lastByte16 = _mm_set1_epi8(pattern.back());
+	const auto firstFold16 = _mm_set1_epi8(firstMask);
+	const auto lastFold16 = _mm_set1_epi8(lastMask);
+	for (; last - position >= 16; position += 16)
+	{
+		auto firstBlock = _mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(position)), firstFold16);
+		auto lastBlock = _mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(position + offset)), lastFold16);
+		auto mask = static_cast<unsigned int>(_mm_movemask_epi8(_mm_and_si128(
+			_mm_cmpeq_epi8(firstBlock, firstByte16),
+			_mm_cmpeq_epi8(lastBlock, lastByte16))));
+		for (; mask != 0; mask &= mask - 1)
+		{
+			auto candidate = position + __builtin_ctz(mask);
+			if (Matches(candidate))
+				return candidate;
+		}
+	}
+#endif
+
+	//Remaining positions (or every position without SIMD support)
+	for (; position < last; ++position)
+		if (Fold(*position) == pattern.front() && Matches(position))
+			return position;
+	return end;
+}
+
+bool TextSearch::Matches(const char* position) const
+{
+	for (auto index = 0ul; index < pattern.size(); ++index)
+		if (Fold(position[index]) != pattern[index])
+			return false;
+	return true;
+}
+
+char TextSearch::Fold(char c)
+{
+	return IsLetter(c) ? (c | 0x20) : c;
+}
+
+bool TextSearch::IsLetter(char c)
+{
+	return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z');
+}
+
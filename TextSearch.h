@@ -0,0 +1,34 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    TextSearch.h
+// Description: This file declares the TextSearch class.  This class finds a
+//              pattern in text ignoring (ASCII) case, the same matches as
+//              std::search with STRING::iequal_char.  Candidate positions are
+//              found 16 (SSE2) or 32 (AVX2) bytes at a time by comparing the
+//              case folded first and last byte of the pattern, and only those
+//              candidates are verified a byte at a time.
+//
+// Created:     2026-10-17 13:31:08
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <string>
+
+class TextSearch
+{
+public:
+	explicit TextSearch(const std::string& pattern);
+
+	std::string::size_type Find(const std::string& text) const;
+	const char* Find(const char* begin, const char* end) const;
+
+private:
+	bool Matches(const char* position) const;
+
+	static char Fold(char c);
+	static bool IsLetter(char c);
+
+private:
+	friend class TextSearchTest;
+	std::string pattern;
+};
+
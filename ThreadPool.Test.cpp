@@ -0,0 +1,75 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    ThreadPool.Test.cpp
+// Description: This file defines all ThreadPool unit tests.
+//
+// Created:     2026-10-17 19:48:26
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#include "ThreadPool.h"
+#include <UnitTest/UnitTest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+using UnitTest::Assert;
+
+TEST_CLASS(ThreadPoolTest)
+{
+public:
+	ThreadPoolTest()
+	{
+	}
+
+	TEST_METHOD(TasksRunOnSeveralWorkers)
+	{
+		//Each task waits until all of them are running, which only happens on separate workers
+		const auto workerCount = 3ul;
+		std::atomic<unsigned long> runningCount(0);
+		{
+			ThreadPool pool(workerCount);
+			Assert::AreEqual(workerCount, pool.GetWorkerCount());
+			for (auto index = 0ul; index < workerCount; ++index)
+				pool.Submit([&]()
+				{
+					++runningCount;
+					while (runningCount < workerCount)
+						std::this_thread::yield();
+				});
+		}
+		Assert::AreEqual(workerCount, runningCount.load());
+	}
+
+	TEST_METHOD(IdleWorkersStealSubmittedTasks)
+	{
+		//The tasks are submitted from one worker onto its own queue, and it stays busy until
+		//the others have taken every one of them
+		const auto taskCount = 100ul;
+		std::atomic<unsigned long> doneCount(0);
+		{
+			ThreadPool pool(4);
+			pool.Submit([&]()
+			{
+				for (auto index = 0ul; index < taskCount; ++index)
+					pool.Submit([&]() { ++doneCount; });
+				while (doneCount < taskCount)
+					std::this_thread::yield();
+			});
+		}
+		Assert::AreEqual(taskCount, doneCount.load());
+	}
+
+	TEST_METHOD(OwnTasksRunNewestFirst)
+	{
+		std::vector<unsigned long> order;
+		{
+			ThreadPool pool(1);
+			pool.Submit([&]()
+			{
+				for (auto index = 0ul; index < 3; ++index)
+					pool.Submit([&order, index]() { order.push_back(index); });
+			});
+		}
+		Assert::AreEqual(3ul, static_cast<unsigned long>(order.size()));
+		Assert::AreEqual(2ul, order[0]);
+		Assert::AreEqual(0ul, order[2]);
+	}
+};
@@ -0,0 +1,159 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    ThreadPool.cpp
+// Description: This file implements all ThreadPool member functions.
+//
+// Created:     2026-10-17 19:48:26
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#include "pch.h"
+#include "ThreadPool.h"
+#include "Settings.h"
+#include "Trace.h"
+
+//The worker (if any) running on this thread, tasks it submits stay on its own queue
+static thread_local ThreadPool* currentPool = nullptr;
+static thread_local unsigned long currentWorker = 0;
+
+//Time the running task waited for a worker after one was free (nanoseconds)
+static thread_local unsigned long long currentTaskOverhead = 0;
+
+ThreadPool::ThreadPool(unsigned long workerCount)
+	: queuedCount(0), runningCount(0), nextWorker(0)
+{
+	for (auto index = 0ul; index < MATH::Max(workerCount, 1ul); ++index)
+		workers.emplace_back(new Worker(*this, index));
+	for (auto& worker: workers)
+		worker->Start();
+}
+
+ThreadPool::~ThreadPool()
+{
+	//The workers finish the tasks still queued (and any those tasks submit) before they exit
+	{
+		std::lock_guard<std::mutex> guard(sleepLock);
+		stopping = true;
+	}
+	taskReady.notify_all();
+	for (auto& worker: workers)
+		worker->Stop();
+}
+
+ThreadPool& ThreadPool::GetInstance()
+{
+	//Sized once per process, a worker count of zero uses every hardware thread
+	static ThreadPool pool([]()
+	{
+		auto workerCount = Settings().GetWorkerThreadCount();
+		return workerCount > 0 ? workerCount : static_cast<unsigned long>(std::thread::hardware_concurrency());
+	}());
+	return pool;
+}
+
+unsigned long long ThreadPool::GetTaskOverhead()
+{
+	return currentTaskOverhead;
+}
+
+void ThreadPool::Submit(const std::function<void()>& task)
+{
+	//The count is raised first so a worker that wakes up keeps looking until the task is queued
+	auto index = currentPool == this ? currentWorker : nextWorker++ % workers.size();
+	{
+		std::lock_guard<std::mutex> guard(sleepLock);
+		++queuedCount;
+	}
+	{
+		auto& worker = *workers[index];
+		std::lock_guard<std::mutex> guard(worker.lock);
+		worker.tasks.push_back({ task, Trace::Now() });
+	}
+	taskReady.notify_one();
+}
+
+unsigned long ThreadPool::GetWorkerCount() const
+{
+	return workers.size();
+}
+
+bool ThreadPool::TakeTask(unsigned long index, Task& task)
+{
+	//The newest task of the worker's own queue first, otherwise the oldest task of another queue
+	for (auto offset = 0ul; offset < workers.size(); ++offset)
+	{
+		auto& worker = *workers[(index + offset) % workers.size()];
+		std::lock_guard<std::mutex> guard(worker.lock);
+		if (worker.tasks.empty())
+			continue;
+		if (offset == 0)
+		{
+			task = std::move(worker.tasks.back());
+			worker.tasks.pop_back();
+		}
+		else
+		{
+			task = std::move(worker.tasks.front());
+			worker.tasks.pop_front();
+		}
+		++runningCount;
+		--queuedCount;
+		return true;
+	}
+	return false;
+}
+
+void ThreadPool::RunWorker(unsigned long index)
+{
+	currentPool = this;
+	currentWorker = index;
+	auto readyTime = Trace::Now();
+	for (;;)
+	{
+		Task task;
+		if (!TakeTask(index, task))
+		{
+			std::unique_lock<std::mutex> guard(sleepLock);
+			taskReady.wait(guard, [&]() { return queuedCount > 0 || (stopping && runningCount == 0); });
+			if (queuedCount == 0)
+				return;
+			continue;
+		}
+
+		//Tasks report their own errors, one that escapes must not take the worker down with it
+		auto overheadStart = MATH::Max(task.submitTime, readyTime);
+		auto startTime = Trace::Now();
+		currentTaskOverhead = startTime - overheadStart;
+		Trace::Record("schedule", overheadStart, startTime);
+		try
+		{
+			task.run();
+		}
+		catch (...)
+		{
+		}
+		readyTime = Trace::Now();
+
+		//A running task can still submit more, so a stopping pool waits for the last one
+		if (--runningCount == 0)
+		{
+			std::lock_guard<std::mutex> guard(sleepLock);
+			if (stopping)
+				taskReady.notify_all();
+		}
+	}
+}
+
+ThreadPool::Worker::Worker(ThreadPool& pool, unsigned long index)
+	: pool(pool), index(index)
+{
+}
+
+ThreadPool::Worker::~Worker()
+{
+	//Joined here since the thread runs a member of this derived class
+	Stop();
+}
+
+void ThreadPool::Worker::Run()
+{
+	pool.RunWorker(index);
+}
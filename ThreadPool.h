@@ -0,0 +1,74 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    ThreadPool.h
+// Description: This file declares the ThreadPool class.  One pool of worker
+//              threads is shared by the build, the unit tests and find in
+//              files, so they no longer create a thread per task or compete
+//              with each other for the cores.  Each worker has its own queue
+//              of tasks, a task submitted from a worker goes on that worker's
+//              queue, and a worker without tasks steals from the others.
+//
+// Created:     2026-10-17 19:48:26
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "BaseThread.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class ThreadPool
+{
+public:
+	explicit ThreadPool(unsigned long workerCount);
+	ThreadPool(const ThreadPool& rhs) = delete;
+	~ThreadPool();
+
+	ThreadPool& operator=(const ThreadPool& rhs) = delete;
+
+	static ThreadPool& GetInstance();
+	static unsigned long long GetTaskOverhead();
+
+	void Submit(const std::function<void()>& task);
+	unsigned long GetWorkerCount() const;
+
+private:
+	friend class ThreadPoolTest;
+
+	struct Task
+	{
+		std::function<void()> run;
+		unsigned long long submitTime;
+	};
+
+	class Worker : public BaseThread
+	{
+	public:
+		Worker(ThreadPool& pool, unsigned long index);
+		~Worker();
+
+		void Run() final;
+
+		std::mutex lock;
+		std::deque<Task> tasks;
+
+	private:
+		ThreadPool& pool;
+		unsigned long index;
+	};
+
+	bool TakeTask(unsigned long index, Task& task);
+	void RunWorker(unsigned long index);
+
+private:
+	std::vector<std::unique_ptr<Worker>> workers;
+	std::mutex sleepLock;
+	std::condition_variable taskReady;
+	std::atomic<long> queuedCount;
+	std::atomic<long> runningCount;
+	std::atomic<unsigned long> nextWorker;
+	bool stopping = false;
+};
@@ -0,0 +1,84 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    Trace.Test.cpp
+// Description: This file defines all Trace unit tests.
+//
+// Created:     2026-10-17 17:12:45
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#include "Trace.h"
+#include <UnitTest/UnitTest.h>
+#include <sstream>
+#include <thread>
+#include <vector>
+using UnitTest::Assert;
+
+TEST_CLASS(TraceTest)
+{
+public:
+	TraceTest()
+	{
+	}
+
+	TEST_METHOD(SpanIsWrittenAsCompleteEvent)
+	{
+		auto count = Trace::GetRecordCount();
+		Trace::Record("test-record", 5000, 7500);
+		{
+			Trace::Span span("test-span");
+		}
+		Assert::AreEqual(static_cast<unsigned long>(count + 2), static_cast<unsigned long>(Trace::GetRecordCount()));
+
+		auto trace = WriteChromeTrace();
+		Assert::IsTrue(trace.find("{\"traceEvents\":[") == 0);
+		Assert::IsTrue(trace.find("{\"name\":\"test-record\",\"ph\":\"X\",\"ts\":5.000,\"dur\":2.500,") != std::string::npos);
+		Assert::IsTrue(trace.find("{\"name\":\"test-span\",\"ph\":\"X\"") != std::string::npos);
+	}
+
+	TEST_METHOD(RingKeepsNewestSpans)
+	{
+		Trace::Record("test-oldest", 0, 1);
+		for (auto index = 0ul; index < Trace::slotCount - 1; ++index)
+			Trace::Record("test-wrapped", index, index + 1);
+		Trace::Record("test-newest", 0, 1);
+
+		auto trace = WriteChromeTrace();
+		Assert::AreEqual(Trace::slotCount, CountEvents(trace));
+		Assert::IsTrue(trace.find("test-oldest") == std::string::npos);
+		Assert::IsTrue(trace.find("test-newest") != std::string::npos);
+	}
+
+	TEST_METHOD(ThreadsRecordWithoutLosingSpans)
+	{
+		const auto threadCount = 4ul;
+		const auto spanCount = 1000ul;
+		auto count = Trace::GetRecordCount();
+		std::vector<std::thread> threads;
+		for (auto index = 0ul; index < threadCount; ++index)
+			threads.emplace_back([&]()
+			{
+				for (auto span = 0ul; span < spanCount; ++span)
+				{
+					Trace::Span trace("test-thread");
+				}
+			});
+		for (auto& thread: threads)
+			thread.join();
+		Assert::AreEqual(threadCount * spanCount, static_cast<unsigned long>(Trace::GetRecordCount() - count));
+	}
+
+private:
+	static std::string WriteChromeTrace()
+	{
+		std::ostringstream out;
+		Trace::WriteChromeTrace(out);
+		return out.str();
+	}
+
+	static unsigned long CountEvents(const std::string& trace)
+	{
+		auto count = 0ul;
+		for (auto position = trace.find("\"ph\":\"X\""); position != std::string::npos; position = trace.find("\"ph\":\"X\"", position + 1))
+			++count;
+		return count;
+	}
+};
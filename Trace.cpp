@@ -0,0 +1,100 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    Trace.cpp
+// Description: This file implements all Trace member functions.
+//
+// Created:     2026-10-17 17:12:45
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#include "pch.h"
+#include "Trace.h"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+
+const unsigned long Trace::slotCount;
+Trace::Slot Trace::slots[Trace::slotCount];
+std::atomic<unsigned long long> Trace::nextTicket(0);
+
+Trace::Span::Span(const char* name)
+	: name(name), start(Now())
+{
+}
+
+Trace::Span::~Span()
+{
+	Record(name, start, Now());
+}
+
+unsigned long long Trace::Now()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void Trace::Record(const char* name, unsigned long long start, unsigned long long end)
+{
+	//Each span claims the next ticket, the oldest span is overwritten once the ring is full.
+	//The sequence is cleared first so a reader never accepts a slot that is half written.
+	auto ticket = nextTicket.fetch_add(1, std::memory_order_relaxed);
+	auto& slot = slots[ticket % slotCount];
+	slot.sequence.store(0, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	slot.name.store(name, std::memory_order_relaxed);
+	slot.start.store(start, std::memory_order_relaxed);
+	slot.duration.store(end - start, std::memory_order_relaxed);
+	slot.threadId.store(::GetCurrentThreadId(), std::memory_order_relaxed);
+	slot.sequence.store(ticket + 1, std::memory_order_release);
+}
+
+unsigned long long Trace::GetRecordCount()
+{
+	return nextTicket.load(std::memory_order_relaxed);
+}
+
+void Trace::WriteChromeTrace(std::ostream& out)
+{
+	//Complete events ("X") with the time stamp and duration in microseconds
+	auto endTicket = nextTicket.load(std::memory_order_acquire);
+	auto firstTicket = endTicket > slotCount ? endTicket - slotCount : 0;
+	auto first = true;
+	out << "{\"traceEvents\":[";
+	for (auto ticket = firstTicket; ticket < endTicket; ++ticket)
+	{
+		const auto& slot = slots[ticket % slotCount];
+		auto sequence = slot.sequence.load(std::memory_order_acquire);
+		if (sequence != ticket + 1)
+			continue;
+		auto name = slot.name.load(std::memory_order_relaxed);
+		auto start = slot.start.load(std::memory_order_relaxed);
+		auto duration = slot.duration.load(std::memory_order_relaxed);
+		auto threadId = slot.threadId.load(std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (slot.sequence.load(std::memory_order_relaxed) != sequence)
+			continue;
+
+		char event[256];
+		std::snprintf(
+			event,
+			sizeof(event),
+			"%s\n{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%llu.%03llu,\"dur\":%llu.%03llu,\"pid\":1,\"tid\":%lu}",
+			first ? "" : ",",
+			name,
+			start / 1000,
+			start % 1000,
+			duration / 1000,
+			duration % 1000,
+			threadId);
+		out << event;
+		first = false;
+	}
+	out << "\n]}\n";
+}
+
+void Trace::SaveChromeTrace(const std::string& fileName)
+{
+	std::ofstream out(fileName.c_str());
+	if (!out)
+		throw std::runtime_error{ "Could not create trace file: " + fileName };
+	WriteChromeTrace(out);
+}
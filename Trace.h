@@ -0,0 +1,60 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    Trace.h
+// Description: This file declares the Trace class.  Timed spans (edit, lex,
+//              layout, paint, find, open and save) are recorded into a fixed
+//              ring of slots without taking a lock, so tracing is always on
+//              and costs two clock reads and an atomic increment per span.
+//              The most recent spans can be written as a Chrome trace (load
+//              it in chrome://tracing or ui.perfetto.dev).
+//
+// Created:     2026-10-17 17:12:45
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <atomic>
+#include <ostream>
+#include <string>
+
+class Trace
+{
+public:
+	//Records the time from construction to destruction, the name must be a string literal
+	class Span
+	{
+	public:
+		explicit Span(const char* name);
+		Span(const Span& rhs) = delete;
+		~Span();
+
+		Span& operator=(const Span& rhs) = delete;
+
+	private:
+		const char* name;
+		unsigned long long start;
+	};
+
+	static const unsigned long slotCount = 65536ul;
+
+	static unsigned long long Now();
+	static void Record(const char* name, unsigned long long start, unsigned long long end);
+	static unsigned long long GetRecordCount();
+
+	static void WriteChromeTrace(std::ostream& out);
+	static void SaveChromeTrace(const std::string& fileName);
+
+private:
+	friend class TraceTest;
+
+	//A slot is being written while its sequence does not match the ticket stored last
+	struct Slot
+	{
+		std::atomic<unsigned long long> sequence;
+		std::atomic<const char*> name;
+		std::atomic<unsigned long long> start;
+		std::atomic<unsigned long long> duration;
+		std::atomic<unsigned long> threadId;
+	};
+
+	static Slot slots[slotCount];
+	static std::atomic<unsigned long long> nextTicket;
+};
@@ -23,7 +23,6 @@ void UnitTestThread::SetTestData(
 	this->command = command;
 	this->workingDirectory = workingDirectory;
 	this->target = target;
-	Start();
 }
 
 bool UnitTestThread::IsDone()
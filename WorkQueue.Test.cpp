@@ -0,0 +1,87 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    WorkQueue.Test.cpp
+// Description: This file defines all WorkQueue unit tests.
+//
+// Created:     2026-10-17 19:12:08
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#include "WorkQueue.h"
+#include <UnitTest/UnitTest.h>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+using UnitTest::Assert;
+
+TEST_CLASS(WorkQueueTest)
+{
+public:
+	WorkQueueTest()
+	{
+	}
+
+	TEST_METHOD(WaitReturnsWhenEveryJobIsDone)
+	{
+		const auto jobCount = 200ul;
+		std::atomic<unsigned long> doneCount(0);
+		ThreadPool pool(4);
+		WorkQueue queue(pool);
+		for (auto index = 0ul; index < jobCount; ++index)
+			queue.Push([&]()
+			{
+				std::this_thread::sleep_for(std::chrono::microseconds(100));
+				++doneCount;
+			});
+		queue.Wait();
+		Assert::AreEqual(jobCount, doneCount.load());
+		Assert::AreEqual(jobCount, queue.GetJobCount());
+		Assert::AreEqual(4ul, queue.GetWorkerCount());
+	}
+
+	TEST_METHOD(QueuesShareThePool)
+	{
+		//Each queue only waits for its own jobs
+		std::atomic<bool> release(false);
+		std::atomic<unsigned long> doneCount(0);
+		ThreadPool pool(2);
+		WorkQueue blocked(pool);
+		blocked.Push([&]()
+		{
+			while (!release)
+				std::this_thread::yield();
+		});
+		{
+			WorkQueue queue(pool);
+			for (auto index = 0; index < 10; ++index)
+				queue.Push([&]() { ++doneCount; });
+			queue.Wait();
+		}
+		Assert::AreEqual(10ul, doneCount.load());
+		release = true;
+		blocked.Wait();
+	}
+
+	TEST_METHOD(JobThatThrowsDoesNotStopTheQueue)
+	{
+		auto ran = false;
+		ThreadPool pool(1);
+		WorkQueue queue(pool);
+		queue.Push([]() { throw std::runtime_error{ "job failed" }; });
+		queue.Push([&]() { ran = true; });
+		queue.Wait();
+		Assert::IsTrue(ran);
+		Assert::AreEqual(2ul, queue.GetJobCount());
+	}
+
+	TEST_METHOD(QueuedJobsRunBeforeDestruction)
+	{
+		std::atomic<unsigned long> doneCount(0);
+		ThreadPool pool(2);
+		{
+			WorkQueue queue(pool);
+			for (auto index = 0; index < 10; ++index)
+				queue.Push([&]() { ++doneCount; });
+		}
+		Assert::AreEqual(10ul, doneCount.load());
+	}
+};
@@ -0,0 +1,70 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    WorkQueue.cpp
+// Description: This file implements all WorkQueue member functions.
+//
+// Created:     2026-10-17 19:12:08
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#include "pch.h"
+#include "WorkQueue.h"
+
+WorkQueue::WorkQueue(ThreadPool& pool)
+	: pool(pool)
+{
+}
+
+WorkQueue::~WorkQueue()
+{
+	//The jobs refer to the queue, so it outlives them
+	Wait();
+}
+
+void WorkQueue::Push(const std::function<void()>& job)
+{
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		++pendingCount;
+	}
+	pool.Submit([this, job]()
+	{
+		//Jobs report their own errors, one that escapes must still count as done
+		auto jobOverhead = ThreadPool::GetTaskOverhead();
+		try
+		{
+			job();
+		}
+		catch (...)
+		{
+		}
+
+		std::lock_guard<std::mutex> guard(lock);
+		overhead += jobOverhead;
+		++jobCount;
+		if (--pendingCount == 0)
+			jobsDone.notify_all();
+	});
+}
+
+void WorkQueue::Wait()
+{
+	std::unique_lock<std::mutex> guard(lock);
+	jobsDone.wait(guard, [&]() { return pendingCount == 0; });
+}
+
+unsigned long WorkQueue::GetWorkerCount() const
+{
+	return pool.GetWorkerCount();
+}
+
+unsigned long WorkQueue::GetJobCount()
+{
+	std::lock_guard<std::mutex> guard(lock);
+	return jobCount;
+}
+
+unsigned long long WorkQueue::GetOverheadPerJob()
+{
+	//Nanoseconds
+	std::lock_guard<std::mutex> guard(lock);
+	return jobCount == 0 ? 0 : overhead / jobCount;
+}
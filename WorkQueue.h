@@ -0,0 +1,45 @@
+////////////////////////////////////////////////////////////////////////////////
+// Filename:    WorkQueue.h
+// Description: This file declares the WorkQueue class.  A work queue is a
+//              group of jobs run on the shared ThreadPool, Wait blocks on a
+//              condition variable until every job of the group has completed,
+//              so nothing polls while the jobs (usually child processes) run.
+//              The scheduler overhead of each job is measured from the moment
+//              it could have started (queued and a worker free) until a worker
+//              started it.
+//
+// Created:     2026-10-17 19:12:08
+// Author:      Jacob Buysse
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "ThreadPool.h"
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+
+class WorkQueue
+{
+public:
+	explicit WorkQueue(ThreadPool& pool);
+	WorkQueue(const WorkQueue& rhs) = delete;
+	~WorkQueue();
+
+	WorkQueue& operator=(const WorkQueue& rhs) = delete;
+
+	void Push(const std::function<void()>& job);
+	void Wait();
+
+	unsigned long GetWorkerCount() const;
+	unsigned long GetJobCount();
+	unsigned long long GetOverheadPerJob();
+
+private:
+	friend class WorkQueueTest;
+
+	ThreadPool& pool;
+	std::mutex lock;
+	std::condition_variable jobsDone;
+	unsigned long pendingCount = 0;
+	unsigned long jobCount = 0;
+	unsigned long long overhead = 0;
+};
@@ -60,9 +60,10 @@
 #define ID_EDIT_TOGGLE_BOOKMARK 1042
 #define ID_EDIT_NEXT_BOOKMARK 1043
 #define ID_EDIT_PREVIOUS_BOOKMARK 1044
+#define ID_EDIT_SELECT_ALL_MATCHES 1045
 
 #define ID_FIRST_DOCUMENT_COMMAND ID_SELECT_NEXT_CHARACTER_VERTICAL
-#define ID_LAST_DOCUMENT_COMMAND ID_EDIT_PREVIOUS_BOOKMARK
+#define ID_LAST_DOCUMENT_COMMAND ID_EDIT_SELECT_ALL_MATCHES
 
 #define ID_FILE_CLOSE_DOCUMENT 2000
 #define ID_FILE_OPEN_CONTAINING_FOLDER 2001
@@ -88,6 +89,7 @@
 #define ID_EDIT_FIND_IN_FILES 2021
 #define ID_TOOLS_EDIT_OPTIONS 2022
 #define ID_EDIT_SWITCH_DOCUMENTS 2023
+#define ID_TOOLS_SAVE_TRACE 2024
 
 //Icons
 #define IDI_APPLICATION_LARGE 101